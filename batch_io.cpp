@@ -0,0 +1,382 @@
+#include "batch_io.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace batch_io {
+
+namespace {
+
+const char kBoardMagic[4] = { '8', 'P', 'Z', 'B' };
+const char kRecordMagic[4] = { '8', 'P', 'Z', 'S' };
+
+FileHeader MakeHeader(const char magic[4], uint64_t count) {
+    FileHeader header;
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = kVersion;
+    header.count = count;
+    return header;
+}
+
+// Checks the header of a mapped file and that it holds exactly 'count'
+// records of 'record_size' bytes.
+bool CheckHeader(const MappedFile& file, const char magic[4],
+                 size_t record_size, uint64_t* count, std::string* error) {
+    FileHeader header;
+    if (file.Size() < sizeof(header)) {
+        *error = "file is too short";
+        return false;
+    }
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0) {
+        *error = "wrong file type";
+        return false;
+    }
+    if (header.version != kVersion) {
+        *error = "unsupported version";
+        return false;
+    }
+    // Compared by division first, so that a huge count cannot wrap the
+    // expected size around to the real one.
+    if (header.count > (file.Size() - sizeof(header)) / record_size ||
+        file.Size() != sizeof(header) + header.count * record_size) {
+        *error = "size does not match the record count";
+        return false;
+    }
+    *count = header.count;
+    return true;
+}
+
+}  // namespace
+
+SolutionRecord MakeRecord(uint32_t key, const Solution& solution) {
+    SolutionRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.board = key;
+    switch (solution.GetStatus()) {
+        case Solution::kFound: record.status = kRecordFound; break;
+        case Solution::kExhausted: record.status = kRecordExhausted; break;
+        case Solution::kTimedOut: record.status = kRecordTimedOut; break;
+        case Solution::kCancelled: record.status = kRecordCancelled; break;
+    }
+    record.length = solution.Length();
+    record.nodes_expanded = solution.GetNodesExpanded();
+    record.max_frontier_size = solution.GetMaxFrontierSize();
+    // Every search returns optimal paths, which are at most 31 moves.
+    for (int i = 0; i < solution.Length() && i < 32; i++) {
+        record.moves |= static_cast<uint64_t>(solution.MoveAt(i)) << (2 * i);
+    }
+    return record;
+}
+
+SolutionRecord MakeUnsolvableRecord(uint32_t key) {
+    SolutionRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.board = key;
+    record.status = kRecordUnsolvable;
+    return record;
+}
+
+std::string RecordMoves(const SolutionRecord& record) {
+    std::string moves;
+    for (int i = 0; i < record.length && i < 32; i++) {
+        moves.push_back(board::MoveLetter(
+            static_cast<board::Move>((record.moves >> (2 * i)) & 3)));
+    }
+    return moves;
+}
+
+MappedFile::MappedFile() : data_(nullptr), size_(0) {}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return false;
+    }
+    size_ = info.st_size;
+    if (size_ > 0) {
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            close(fd);
+            size_ = 0;
+            return false;
+        }
+        madvise(data, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(data);
+    }
+    close(fd);  // The mapping stays valid on its own.
+    return true;
+}
+
+const char* MappedFile::Data() const {
+    return data_;
+}
+
+size_t MappedFile::Size() const {
+    return size_;
+}
+
+void MappedFile::Close() {
+    if (data_ != nullptr) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool BoardFile::Open(const std::string& path, std::string* error) {
+    keys_ = nullptr;
+    count_ = 0;
+    if (!file_.Open(path)) {
+        *error = std::strerror(errno);
+        return false;
+    }
+    if (!CheckHeader(file_, kBoardMagic, sizeof(uint32_t), &count_, error)) {
+        return false;
+    }
+    keys_ = reinterpret_cast<const uint32_t*>(file_.Data() +
+                                              sizeof(FileHeader));
+    for (uint64_t i = 0; i < count_; i++) {
+        if (keys_[i] >= board::kNumKeys) {
+            *error = "invalid board";
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t BoardFile::Count() const {
+    return count_;
+}
+
+uint32_t BoardFile::Key(uint64_t i) const {
+    return keys_[i];
+}
+
+BufferedWriter::BufferedWriter(int fd, size_t capacity)
+    : fd_(fd), buffer_(capacity), used_(0), failed_(false) {}
+
+BufferedWriter::~BufferedWriter() {
+    Flush();
+}
+
+void BufferedWriter::Write(const void* data, size_t size) {
+    if (size <= buffer_.size() - used_) {
+        std::memcpy(&buffer_[used_], data, size);
+        used_ += size;
+    } else {
+        WriteThrough(data, size);
+    }
+}
+
+void BufferedWriter::Write(const std::string& text) {
+    Write(text.data(), text.size());
+}
+
+bool BufferedWriter::Flush() {
+    WriteThrough(nullptr, 0);
+    bool ok = !failed_;
+    failed_ = false;
+    return ok;
+}
+
+void BufferedWriter::WriteThrough(const void* data, size_t size) {
+    iovec parts[2];
+    parts[0].iov_base = &buffer_[0];
+    parts[0].iov_len = used_;
+    parts[1].iov_base = const_cast<void*>(data);
+    parts[1].iov_len = size;
+    int first = 0;
+    while (first < 2) {
+        if (parts[first].iov_len == 0) {
+            first++;
+            continue;
+        }
+        ssize_t written = writev(fd_, parts + first, 2 - first);
+        if (written < 0) {
+            if (errno == EINTR) { continue; }
+            failed_ = true;
+            break;
+        }
+        // Skip past whatever the kernel accepted, which may end mid-part.
+        while (first < 2 && static_cast<size_t>(written) >=
+               parts[first].iov_len) {
+            written -= parts[first].iov_len;
+            parts[first].iov_len = 0;
+            first++;
+        }
+        if (first < 2) {
+            parts[first].iov_base =
+                static_cast<char*>(parts[first].iov_base) + written;
+            parts[first].iov_len -= written;
+        }
+    }
+    used_ = 0;
+}
+
+RecordFileWriter::RecordFileWriter()
+    : fd_(-1), count_(0) {}
+
+RecordFileWriter::~RecordFileWriter() {
+    Close();
+}
+
+bool RecordFileWriter::Open(const std::string& path) {
+    Close();
+    fd_ = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return false;
+    }
+    writer_.reset(new BufferedWriter(fd_));
+    FileHeader header = MakeHeader(kRecordMagic, 0);
+    writer_->Write(&header, sizeof(header));
+    count_ = 0;
+    return true;
+}
+
+void RecordFileWriter::Append(const SolutionRecord& record) {
+    writer_->Write(&record, sizeof(record));
+    count_++;
+}
+
+bool RecordFileWriter::Close() {
+    if (fd_ < 0) {
+        return true;
+    }
+    bool ok = writer_->Flush();
+    writer_.reset();
+    FileHeader header = MakeHeader(kRecordMagic, count_);
+    ok = pwrite(fd_, &header, sizeof(header), 0) ==
+        static_cast<ssize_t>(sizeof(header)) && ok;
+    ok = close(fd_) == 0 && ok;
+    fd_ = -1;
+    return ok;
+}
+
+bool WriteBoardFile(const std::string& path,
+                    const std::vector<uint32_t>& keys) {
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                  0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok;
+    {
+        BufferedWriter writer(fd);
+        FileHeader header = MakeHeader(kBoardMagic, keys.size());
+        writer.Write(&header, sizeof(header));
+        if (!keys.empty()) {
+            writer.Write(&keys[0], keys.size() * sizeof(uint32_t));
+        }
+        ok = writer.Flush();
+    }
+    return close(fd) == 0 && ok;
+}
+
+bool ReadRecordFile(const std::string& path,
+                    std::vector<SolutionRecord>* records, std::string* error) {
+    MappedFile file;
+    if (!file.Open(path)) {
+        *error = std::strerror(errno);
+        return false;
+    }
+    uint64_t count;
+    if (!CheckHeader(file, kRecordMagic, sizeof(SolutionRecord), &count,
+                     error)) {
+        return false;
+    }
+    records->resize(count);
+    if (count > 0) {
+        std::memcpy(&(*records)[0], file.Data() + sizeof(FileHeader),
+                    count * sizeof(SolutionRecord));
+    }
+    return true;
+}
+
+bool ParseTextBoards(const char* data, size_t size,
+                     std::vector<uint32_t>* keys, std::string* error) {
+    uint8_t cells[board::kCells];
+    int filled = 0;
+    int line = 1;
+    size_t i = 0;
+    while (i < size) {
+        char c = data[i];
+        if (c == '\n') {
+            line++;
+            i++;
+            continue;
+        }
+        if (c == ' ' || c == '\t' || c == '\r' || c == '[' || c == ']' ||
+            c == ',') {
+            i++;
+            continue;
+        }
+        size_t begin = i;
+        while (i < size && data[i] >= '0' && data[i] <= '9') {
+            i++;
+        }
+        size_t digits = i - begin;
+        if (digits == 1 || (digits == board::kCells && filled == 0)) {
+            for (size_t j = begin; j < i; j++) {
+                cells[filled++] = data[j] - '0';
+            }
+        } else {
+            std::ostringstream message;
+            message << "line " << line << ": unexpected " <<
+                (digits ? "number" : "character");
+            *error = message.str();
+            return false;
+        }
+        if (filled == board::kCells) {
+            bool seen[board::kCells] = { false };
+            for (int j = 0; j < board::kCells; j++) {
+                if (cells[j] >= board::kCells || seen[cells[j]]) {
+                    std::ostringstream message;
+                    message << "line " << line <<
+                        ": tiles must be 0-8, each used once";
+                    *error = message.str();
+                    return false;
+                }
+                seen[cells[j]] = true;
+            }
+            keys->push_back(board::ToKey(cells));
+            filled = 0;
+        }
+    }
+    if (filled != 0) {
+        *error = "incomplete board at end of input";
+        return false;
+    }
+    return true;
+}
+
+std::string FormatGrid(uint32_t key) {
+    uint8_t cells[board::kCells];
+    board::FromKey(key, cells);
+    std::string text;
+    for (int i = 0; i < board::kCells; i++) {
+        text.push_back('0' + cells[i]);
+        text.push_back(i % board::kSide == board::kSide - 1 ? '\n' : ' ');
+    }
+    text.push_back('\n');
+    return text;
+}
+
+}  // namespace batch_io
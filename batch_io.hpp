@@ -0,0 +1,208 @@
+#ifndef BATCH_IO_HPP
+#define BATCH_IO_HPP
+
+#include "board.hpp"
+#include "solution.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Binary batch formats. Both files start with a 16 byte header: a four
+/// byte magic, a uint32 version and a uint64 record count, followed by
+/// fixed-size records. The structs below are written and read as they lie
+/// in memory, so all integers are in the byte order of the machine that
+/// wrote the file (little endian on x86 and ARM), and files do not move
+/// between machines of different byte order.
+///
+///   Board file ("8PZB"):    one uint32 board::ToKey() per puzzle.
+///   Solution file ("8PZS"): one SolutionRecord per puzzle, in the order
+///                           of the board file.
+namespace batch_io {
+
+const uint32_t kVersion = 1;
+
+/// @brief Header shared by the board and solution files.
+struct FileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+};
+static_assert(sizeof(FileHeader) == 16, "FileHeader must be 16 bytes");
+
+/// @brief Outcome stored in SolutionRecord::status.
+enum RecordStatus : uint8_t {
+    kRecordFound = 0,
+    kRecordExhausted = 1,
+    kRecordTimedOut = 2,
+    kRecordUnsolvable = 3,
+    kRecordCancelled = 4
+};
+
+/// @brief Fixed-size result of solving one puzzle. The longest optimal
+/// 8-puzzle solution has 31 moves, so the moves always fit in 'moves'.
+struct SolutionRecord {
+    uint32_t board;              // board::ToKey() of the start state.
+    uint8_t status;              // A RecordStatus.
+    uint8_t length;              // Number of moves.
+    uint16_t reserved;           // Zero.
+    uint32_t nodes_expanded;
+    uint32_t max_frontier_size;
+    uint64_t moves;              // Two bits per board::Move, first lowest.
+};
+static_assert(sizeof(SolutionRecord) == 24,
+              "SolutionRecord must be 24 bytes");
+
+/// @brief Builds the record for a finished search.
+/// @param key board::ToKey() of the start state.
+/// @param solution Result of the search.
+SolutionRecord MakeRecord(uint32_t key, const Solution& solution);
+
+/// @brief Builds the record for a puzzle that was never searched because
+/// it cannot be solved.
+SolutionRecord MakeUnsolvableRecord(uint32_t key);
+
+/// @brief Rebuilds the move string of a record, for example "ULDR".
+std::string RecordMoves(const SolutionRecord& record);
+
+/// @brief MappedFile maps a whole file read-only into memory, so batches
+/// are read without copying them through stream buffers.
+class MappedFile {
+ public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Maps 'path'. Any previously mapped file is released.
+    /// @return false if the file cannot be opened or mapped.
+    bool Open(const std::string& path);
+
+    /// @brief Accesses the mapped bytes.
+    const char* Data() const;
+
+    /// @brief Accesses the number of mapped bytes.
+    size_t Size() const;
+
+ private:
+    void Close();
+
+    const char* data_;
+    size_t size_;
+};
+
+/// @brief BoardFile reads a binary board file through a MappedFile.
+class BoardFile {
+ public:
+    /// @brief Maps and validates a board file.
+    /// @param error Set to the reason on failure.
+    /// @return false if the file is missing or not a valid board file.
+    bool Open(const std::string& path, std::string* error);
+
+    /// @brief Accesses the number of boards in the file.
+    uint64_t Count() const;
+
+    /// @brief Accesses one board.
+    /// @param i Index below Count().
+    /// @return board::ToKey() of the board.
+    uint32_t Key(uint64_t i) const;
+
+ private:
+    MappedFile file_;
+    const uint32_t* keys_;
+    uint64_t count_;
+};
+
+/// @brief BufferedWriter collects small writes in a large buffer and hands
+/// them to the kernel in big chunks. Writes larger than the free space go
+/// out together with the buffer in a single writev() call instead of being
+/// copied. Nothing is flushed per line.
+class BufferedWriter {
+ public:
+    /// @brief Constructs a writer for an already open file descriptor.
+    /// @param fd Descriptor to write to. Not closed by the writer.
+    /// @param capacity Buffer size in bytes.
+    explicit BufferedWriter(int fd, size_t capacity = 1 << 20);
+
+    /// @brief Flushes whatever is still buffered.
+    ~BufferedWriter();
+
+    /// @brief Appends bytes to the output.
+    void Write(const void* data, size_t size);
+
+    /// @brief Appends a string to the output.
+    void Write(const std::string& text);
+
+    /// @brief Hands all buffered bytes to the kernel.
+    /// @return false if any write since the last Flush() failed.
+    bool Flush();
+
+ private:
+    /// @brief Writes the buffer followed by 'data' with writev().
+    void WriteThrough(const void* data, size_t size);
+
+    int fd_;
+    std::vector<char> buffer_;
+    size_t used_;
+    bool failed_;
+};
+
+/// @brief RecordFileWriter creates a binary solution file. The header is
+/// written first with a count of zero and patched by Close().
+class RecordFileWriter {
+ public:
+    RecordFileWriter();
+    ~RecordFileWriter();
+
+    /// @brief Creates or truncates 'path'.
+    /// @return false if the file cannot be created.
+    bool Open(const std::string& path);
+
+    /// @brief Appends one record.
+    void Append(const SolutionRecord& record);
+
+    /// @brief Flushes the records and writes the final count.
+    /// @return false if any write failed.
+    bool Close();
+
+ private:
+    int fd_;
+    std::unique_ptr<BufferedWriter> writer_;
+    uint64_t count_;
+};
+
+/// @brief Writes a binary board file in one go.
+/// @param path File to create or truncate.
+/// @param keys board::ToKey() of each board, in order.
+/// @return false if any write failed.
+bool WriteBoardFile(const std::string& path,
+                    const std::vector<uint32_t>& keys);
+
+/// @brief Reads every record of a binary solution file.
+/// @param error Set to the reason on failure.
+/// @return false if the file is missing or not a valid solution file.
+bool ReadRecordFile(const std::string& path,
+                    std::vector<SolutionRecord>* records, std::string* error);
+
+/// @brief Parses boards written as text. A board is nine tiles, given
+/// either as a single nine-digit word ("123456780", the board::Parse()
+/// format) or as nine separate numbers spread over any number of lines
+/// (the grid printed by the solver, with or without its brackets).
+/// @param data Text to parse.
+/// @param size Number of bytes in 'data'.
+/// @param keys Receives board::ToKey() of every board, in order.
+/// @param error Set to the reason on failure.
+/// @return false if the text holds anything else or an invalid board.
+bool ParseTextBoards(const char* data, size_t size,
+                     std::vector<uint32_t>* keys, std::string* error);
+
+/// @brief Formats a board as three rows of space separated tiles followed
+/// by a blank line, which ParseTextBoards() reads back.
+std::string FormatGrid(uint32_t key);
+
+}  // namespace batch_io
+
+#endif // BATCH_IO_HPP
@@ -0,0 +1,167 @@
+#include "board.hpp"
+
+namespace board {
+
+namespace {
+
+const char* const kMoveNames[] = { "UP", "DOWN", "LEFT", "RIGHT" };
+const char kMoveLetters[] = { 'U', 'D', 'L', 'R' };
+const uint32_t kFactorials[] = { 1, 1, 2, 6, 24, 120, 720, 5040, 40320 };
+
+// Reflect(): the cell each cell is transposed to, and the tile each tile
+// is relabeled as, which is the tile whose goal cell is transposed to.
+const int kReflectedCell[] = { 0, 3, 6, 1, 4, 7, 2, 5, 8 };
+const uint64_t kReflectedTile[] = { 0, 1, 4, 7, 2, 5, 8, 3, 6 };
+
+}  // namespace
+
+const char* MoveName(Move move) {
+    return kMoveNames[move];
+}
+
+Move MoveFromName(const std::string& action) {
+    for (int i = 0; i < 4; i++) {
+        if (action == kMoveNames[i]) {
+            return static_cast<Move>(i);
+        }
+    }
+    return kUp;
+}
+
+char MoveLetter(Move move) {
+    return kMoveLetters[move];
+}
+
+Move Inverse(Move move) {
+    // UP/DOWN and LEFT/RIGHT only differ in their lowest bit.
+    return static_cast<Move>(move ^ 1);
+}
+
+Move Mirror(Move move) {
+    // UP/LEFT and DOWN/RIGHT only differ in their second bit.
+    return static_cast<Move>(move ^ 2);
+}
+
+uint32_t ToKey(const uint8_t cells[kCells]) {
+    // Lehmer code: for each cell count the smaller tiles that come after it.
+    uint32_t key = 0;
+    for (int i = 0; i < kCells - 1; i++) {
+        int smaller = 0;
+        for (int j = i + 1; j < kCells; j++) {
+            if (cells[j] < cells[i]) {
+                smaller++;
+            }
+        }
+        key += smaller * kFactorials[kCells - 1 - i];
+    }
+    return key;
+}
+
+uint32_t ToKey(const std::vector<std::vector<int>>& state) {
+    uint8_t cells[kCells];
+    for (int i = 0; i < kSide; i++) {
+        for (int j = 0; j < kSide; j++) {
+            cells[i * kSide + j] = state[i][j];
+        }
+    }
+    return ToKey(cells);
+}
+
+void FromKey(uint32_t key, uint8_t cells[kCells]) {
+    bool used[kCells] = { false };
+    for (int i = 0; i < kCells; i++) {
+        int smaller = key / kFactorials[kCells - 1 - i];
+        key %= kFactorials[kCells - 1 - i];
+        int tile = 0;
+        while (used[tile] || smaller > 0) {
+            if (!used[tile]) {
+                smaller--;
+            }
+            tile++;
+        }
+        used[tile] = true;
+        cells[i] = tile;
+    }
+}
+
+std::vector<std::vector<int>> FromKey(uint32_t key) {
+    uint8_t cells[kCells];
+    FromKey(key, cells);
+    return FromCells(cells);
+}
+
+std::vector<std::vector<int>> FromCells(const uint8_t cells[kCells]) {
+    std::vector<std::vector<int>> state(kSide, std::vector<int>(kSide));
+    for (int i = 0; i < kCells; i++) {
+        state[i / kSide][i % kSide] = cells[i];
+    }
+    return state;
+}
+
+bool Parse(const std::string& text, std::vector<std::vector<int>>* state) {
+    if (text.size() != static_cast<size_t>(kCells)) {
+        return false;
+    }
+    bool seen[kCells] = { false };
+    std::vector<std::vector<int>> parsed(kSide, std::vector<int>(kSide));
+    for (int i = 0; i < kCells; i++) {
+        int tile = text[i] - '0';
+        if (tile < 0 || tile >= kCells || seen[tile]) {
+            return false;
+        }
+        seen[tile] = true;
+        parsed[i / kSide][i % kSide] = tile;
+    }
+    *state = parsed;
+    return true;
+}
+
+std::string Format(const std::vector<std::vector<int>>& state) {
+    std::string str(kCells, '0');
+    for (int i = 0; i < kSide; i++) {
+        for (int j = 0; j < kSide; j++) {
+            str[i * kSide + j] = '0' + state[i][j];
+        }
+    }
+    return str;
+}
+
+uint64_t Pack(const std::vector<std::vector<int>>& state) {
+    uint64_t packed = 0;
+    for (int i = 0; i < kCells; i++) {
+        uint64_t tile = state[i / kSide][i % kSide];
+        packed |= tile << (4 * i);
+        if (tile == 0) {
+            packed |= static_cast<uint64_t>(i) << 36;
+        }
+    }
+    return packed;
+}
+
+std::vector<std::vector<int>> Unpack(uint64_t state) {
+    std::vector<std::vector<int>> unpacked(kSide, std::vector<int>(kSide));
+    for (int i = 0; i < kCells; i++) {
+        unpacked[i / kSide][i % kSide] = PackedTile(state, i);
+    }
+    return unpacked;
+}
+
+uint32_t PackedKey(uint64_t state) {
+    uint8_t cells[kCells];
+    for (int i = 0; i < kCells; i++) {
+        cells[i] = PackedTile(state, i);
+    }
+    return ToKey(cells);
+}
+
+uint64_t Reflect(uint64_t state) {
+    uint64_t reflected =
+        static_cast<uint64_t>(kReflectedCell[PackedBlank(state)]) << 36;
+    for (int i = 0; i < kCells; i++) {
+        reflected |= kReflectedTile[PackedTile(state, i)] <<
+            (4 * kReflectedCell[i]);
+    }
+    return reflected;
+}
+
+}  // namespace board
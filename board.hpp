@@ -0,0 +1,125 @@
+#ifndef BOARD_HPP
+#define BOARD_HPP
+
+#include "tables.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief Compact helpers for the 3x3 board used throughout the solver.
+/// A board is identified by its permutation rank (its "key"), which is a
+/// dense integer in [0, kNumKeys) and can therefore index flat tables
+/// directly. Moves are stored in two bits so that whole paths can be kept
+/// in a handful of bytes.
+///
+/// The searches themselves work on "packed" states: a uint64_t holding the
+/// tile of cell i in bits 4i to 4i+3 and the blank's cell in bits 36-39.
+/// Applying a move to a packed state is a few shifts and masks.
+namespace board {
+
+const int kSide = 3;
+const int kCells = kSide * kSide;
+const uint32_t kNumKeys = 362880;  // 9!
+
+/// @brief The actions understood by Problem::ToState, in the same order as
+/// Problem::GetActions(). Each one names the direction the blank moves.
+enum Move : uint8_t { kUp = 0, kDown = 1, kLeft = 2, kRight = 3 };
+
+/// @brief Converts a Move to the action string used by Problem.
+/// @return One of "UP", "DOWN", "LEFT", "RIGHT".
+const char* MoveName(Move move);
+
+/// @brief Converts an action string used by Problem to a Move.
+/// @param action One of "UP", "DOWN", "LEFT", "RIGHT".
+Move MoveFromName(const std::string& action);
+
+/// @brief Single letter used when printing move sequences.
+/// @return One of 'U', 'D', 'L', 'R'.
+char MoveLetter(Move move);
+
+/// @brief Gets the move that undoes 'move'.
+Move Inverse(Move move);
+
+/// @brief Gets the move that corresponds to 'move' on the board reflected
+/// by Reflect(): UP and LEFT swap, and so do DOWN and RIGHT.
+Move Mirror(Move move);
+
+/// @brief Ranks a 3x3 state among all permutations of its tiles.
+/// @param state 3x3 puzzle state containing each of 0-8 exactly once.
+/// @return Dense key in [0, kNumKeys).
+uint32_t ToKey(const std::vector<std::vector<int>>& state);
+
+/// @brief Same as ToKey() for a state stored as a flat row-major array.
+uint32_t ToKey(const uint8_t cells[kCells]);
+
+/// @brief Inverse of ToKey().
+/// @param key Value previously returned by ToKey().
+/// @return The 3x3 state with that rank.
+std::vector<std::vector<int>> FromKey(uint32_t key);
+
+/// @brief Inverse of ToKey() that writes a flat row-major array.
+void FromKey(uint32_t key, uint8_t cells[kCells]);
+
+/// @brief Builds the 3x3 state held in a flat row-major array.
+std::vector<std::vector<int>> FromCells(const uint8_t cells[kCells]);
+
+/// @brief Reads a state written as nine digits in row-major order, the
+/// same format as Node::ToString(). Example: "123456780" is the goal.
+/// @param text String to parse.
+/// @param state Filled with the 3x3 state on success.
+/// @return false if 'text' is not a permutation of the digits 0-8.
+bool Parse(const std::string& text, std::vector<std::vector<int>>* state);
+
+/// @brief Writes a state as nine digits in row-major order.
+/// @param state 3x3 puzzle state.
+/// @return String accepted by Parse().
+std::string Format(const std::vector<std::vector<int>>& state);
+
+/// @brief Packs a 3x3 state into a uint64_t.
+uint64_t Pack(const std::vector<std::vector<int>>& state);
+
+/// @brief Inverse of Pack().
+std::vector<std::vector<int>> Unpack(uint64_t state);
+
+/// @brief Same as ToKey() for a packed state.
+uint32_t PackedKey(uint64_t state);
+
+/// @brief Reflects a packed state about the main diagonal and relabels the
+/// tiles so that the goal maps to itself: 2 and 4 swap, as do 3 and 7, and
+/// 6 and 8. A state and its reflection are exactly as far from the goal,
+/// and a path for one turns into a path for the other through Mirror().
+uint64_t Reflect(uint64_t state);
+
+/// @brief Reads the tile on one cell of a packed state.
+/// @param cell Row-major cell index, 0-8.
+inline int PackedTile(uint64_t state, int cell) {
+    return (state >> (4 * cell)) & 0xF;
+}
+
+/// @brief Reads the cell holding the blank in a packed state.
+inline int PackedBlank(uint64_t state) {
+    return (state >> 36) & 0xF;
+}
+
+/// @brief Packed equivalent of Problem::ToState().
+/// @param state Packed state to move from.
+/// @param move Direction the blank moves.
+/// @param next Receives the packed state after the move.
+/// @return false, leaving 'next' untouched, if the blank is on the edge.
+inline bool ApplyMove(uint64_t state, Move move, uint64_t* next) {
+    int blank = PackedBlank(state);
+    int target = tables::kNeighbor[blank][move];
+    if (target < 0) {
+        return false;
+    }
+    uint64_t tile = (state >> (4 * target)) & 0xF;
+    state &= ~((0xFULL << (4 * target)) | (0xFULL << 36));
+    state |= (tile << (4 * blank)) | (static_cast<uint64_t>(target) << 36);
+    *next = state;
+    return true;
+}
+
+}  // namespace board
+
+#endif // BOARD_HPP
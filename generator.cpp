@@ -0,0 +1,140 @@
+#include "generator.hpp"
+#include "tables.hpp"
+
+#include <algorithm>
+
+DistanceTable::DistanceTable()
+    : distance_(board::kNumKeys, kUnreachable) {
+    const uint8_t kGoal[board::kCells] = { 1, 2, 3, 4, 5, 6, 7, 8, 0 };
+    uint32_t goal = board::ToKey(kGoal);
+    distance_[goal] = 0;
+    layers_.push_back(std::vector<uint32_t>(1, goal));
+
+    // Each layer is expanded in full before the next one, so the layers
+    // double as the breadth first search queue.
+    while (true) {
+        const std::vector<uint32_t>& current = layers_.back();
+        std::vector<uint32_t> next;
+        int depth = layers_.size();
+        for (uint32_t key : current) {
+            uint8_t cells[board::kCells];
+            board::FromKey(key, cells);
+            int blank = 0;
+            while (cells[blank] != 0) { blank++; }
+            for (int move = 0; move < 4; move++) {
+                int target = tables::kNeighbor[blank][move];
+                if (target < 0) { continue; }
+                cells[blank] = cells[target];
+                cells[target] = 0;
+                uint32_t neighbor = board::ToKey(cells);
+                cells[target] = cells[blank];
+                cells[blank] = 0;
+                if (distance_[neighbor] == kUnreachable) {
+                    distance_[neighbor] = depth;
+                    next.push_back(neighbor);
+                }
+            }
+        }
+        if (next.empty()) { break; }
+        layers_.push_back(std::move(next));
+    }
+}
+
+int DistanceTable::Distance(uint32_t key) const {
+    return distance_[key];
+}
+
+int DistanceTable::MaxDistance() const {
+    return layers_.size() - 1;
+}
+
+const std::vector<uint32_t>& DistanceTable::Layer(int depth) const {
+    return layers_[depth];
+}
+
+SolvableBoardList::SolvableBoardList() {
+    lines_.reserve(board::kNumKeys / 2 * kLineLength);
+    char tiles[] = "012345678";
+    do {
+        // Solvable exactly when the tiles, ignoring the blank, have an
+        // even number of inversions.
+        int inversions = 0;
+        for (int i = 0; i < board::kCells; i++) {
+            for (int j = i + 1; j < board::kCells; j++) {
+                inversions += tiles[i] != '0' && tiles[j] != '0' &&
+                    tiles[j] < tiles[i];
+            }
+        }
+        if (inversions % 2 == 0) {
+            lines_.insert(lines_.end(), tiles, tiles + board::kCells);
+            lines_.push_back('\n');
+        }
+    } while (std::next_permutation(tiles, tiles + board::kCells));
+}
+
+uint32_t SolvableBoardList::Size() const {
+    return lines_.size() / kLineLength;
+}
+
+const char* SolvableBoardList::Line(uint32_t i) const {
+    return &lines_[i * kLineLength];
+}
+
+BoardGenerator::BoardGenerator(uint64_t seed) : state_(seed) {}
+
+void BoardGenerator::NextUniform(uint8_t cells[board::kCells]) {
+    // Fisher-Yates shuffle of the goal, treating the blank as tile 9 so
+    // that the goal is the identity and every real swap flips parity.
+    const uint8_t kGoal[board::kCells] = { 1, 2, 3, 4, 5, 6, 7, 8, 0 };
+    for (int i = 0; i < board::kCells; i++) {
+        cells[i] = kGoal[i];
+    }
+    // All eight swap positions come from one 64-bit draw: multiplying by
+    // the bound moves a uniform index into the high word and leaves fresh
+    // bits in the low word for the next one.
+    int parity = 0;
+    uint64_t bits = Next();
+    for (int i = board::kCells - 1; i > 0; i--) {
+        unsigned __int128 product =
+            static_cast<unsigned __int128>(bits) * (i + 1);
+        int j = static_cast<int>(product >> 64);
+        bits = static_cast<uint64_t>(product);
+        uint8_t tile = cells[i];
+        cells[i] = cells[j];
+        cells[j] = tile;
+        parity ^= j != i;
+    }
+    int blank = 0;
+    for (int i = 0; i < board::kCells; i++) {
+        blank += i * (cells[i] == 0);  // Branch free; the blank is random.
+    }
+    // The tiles alone form an even permutation exactly when the whole
+    // permutation's parity matches the blank's distance from its goal cell.
+    if ((parity + board::kCells - 1 - blank) % 2 != 0) {
+        // Swapping two tiles is a bijection between unsolvable and
+        // solvable boards, so the result stays uniform.
+        int a = blank == 0 ? 1 : 0;
+        int b = blank <= 1 ? 2 : 1;
+        uint8_t tile = cells[a];
+        cells[a] = cells[b];
+        cells[b] = tile;
+    }
+}
+
+void BoardGenerator::NextAtDepth(const DistanceTable& distances, int depth,
+                                 uint8_t cells[board::kCells]) {
+    const std::vector<uint32_t>& layer = distances.Layer(depth);
+    board::FromKey(layer[Below(layer.size())], cells);
+}
+
+uint64_t BoardGenerator::Next() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+uint32_t BoardGenerator::Below(uint32_t bound) {
+    // Multiply-shift maps the random bits onto [0, bound) without a divide.
+    return (static_cast<unsigned __int128>(Next()) * bound) >> 64;
+}
@@ -0,0 +1,94 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include "board.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/// @brief DistanceTable holds the exact number of moves from every 3x3
+/// state to the goal. It is filled by a breadth first search backward from
+/// the goal, which also groups the states into layers by distance.
+class DistanceTable {
+ public:
+    /// @brief Distance() value of states that cannot reach the goal.
+    static const int kUnreachable = 255;
+
+    /// @brief Runs the search. Takes a fraction of a second.
+    DistanceTable();
+
+    /// @brief Accesses the optimal solution length of a state.
+    /// @param key Value returned by board::ToKey().
+    /// @return Number of moves, or kUnreachable if the state is unsolvable.
+    int Distance(uint32_t key) const;
+
+    /// @brief Accesses the largest distance of any solvable state (31).
+    int MaxDistance() const;
+
+    /// @brief Accesses every state at the same distance from the goal.
+    /// @param depth Distance between 0 and MaxDistance().
+    /// @return Keys of the states in that layer.
+    const std::vector<uint32_t>& Layer(int depth) const;
+
+ private:
+    std::vector<uint8_t> distance_;
+    std::vector<std::vector<uint32_t>> layers_;
+};
+
+/// @brief SolvableBoardList is every solvable board, already written out
+/// in the batch input format. Picking random lines from it is several
+/// times faster than shuffling and formatting a board each time, which
+/// matters when streaming millions of boards.
+class SolvableBoardList {
+ public:
+    /// @brief Length of each line: nine digits and a newline.
+    static const int kLineLength = board::kCells + 1;
+
+    /// @brief Enumerates the boards (181440 lines, 1.8 MB).
+    SolvableBoardList();
+
+    /// @brief Accesses the number of boards in the list.
+    uint32_t Size() const;
+
+    /// @brief Accesses one board as text.
+    /// @param i Index below Size().
+    /// @return kLineLength characters, not null terminated.
+    const char* Line(uint32_t i) const;
+
+ private:
+    std::vector<char> lines_;
+};
+
+/// @brief BoardGenerator produces random solvable boards for load testing.
+/// A given seed always yields the same sequence of boards.
+class BoardGenerator {
+ public:
+    /// @brief Constructs a generator.
+    /// @param seed Any value. Runs with the same seed repeat exactly.
+    explicit BoardGenerator(uint64_t seed);
+
+    /// @brief Draws a board uniformly from all solvable boards.
+    /// @param cells Receives the tiles in row-major order.
+    void NextUniform(uint8_t cells[board::kCells]);
+
+    /// @brief Draws a random index.
+    /// @param bound Number of possible values.
+    /// @return Value in [0, bound), uniform up to a 2^-32 bias.
+    uint32_t Below(uint32_t bound);
+
+    /// @brief Draws a board uniformly from those exactly 'depth' moves
+    /// from the goal.
+    /// @param distances Table that supplies the layer to sample from.
+    /// @param depth Optimal solution length, at most MaxDistance().
+    /// @param cells Receives the tiles in row-major order.
+    void NextAtDepth(const DistanceTable& distances, int depth,
+                     uint8_t cells[board::kCells]);
+
+ private:
+    /// @brief Next 64 random bits (splitmix64).
+    uint64_t Next();
+
+    uint64_t state_;
+};
+
+#endif // GENERATOR_HPP
@@ -0,0 +1,44 @@
+#include "learned_heuristic.hpp"
+
+LearnedHeuristic::LearnedHeuristic(bool learn_closed)
+    : learn_closed_(learn_closed),
+      values_(new std::atomic<uint8_t>[board::kNumKeys]()), lookups_(0),
+      known_(0), tightened_(0), states_learned_(0) {}
+
+void LearnedHeuristic::LearnBound(uint64_t state, int bound) {
+    if (bound <= 0) {
+        return;
+    }
+    int added = Raise(board::PackedKey(state), bound);
+    uint64_t reflected = board::Reflect(state);
+    if (reflected != state) {
+        added += Raise(board::PackedKey(reflected), bound);
+    }
+    if (added) {
+        states_learned_.fetch_add(added, std::memory_order_relaxed);
+    }
+}
+
+void LearnedHeuristic::LearnPath(uint64_t start, const Solution& solution) {
+    uint64_t state = start;
+    for (int step = 0; step < solution.Length(); step++) {
+        LearnBound(state, solution.Length() - step);
+        board::ApplyMove(state, solution.MoveAt(step), &state);
+    }
+}
+
+void LearnedHeuristic::CountLookups(long long lookups, long long known,
+                                    long long tightened) {
+    lookups_.fetch_add(lookups, std::memory_order_relaxed);
+    known_.fetch_add(known, std::memory_order_relaxed);
+    tightened_.fetch_add(tightened, std::memory_order_relaxed);
+}
+
+bool LearnedHeuristic::Raise(uint32_t key, int bound) {
+    uint8_t current = values_[key].load(std::memory_order_relaxed);
+    while (current < bound &&
+           !values_[key].compare_exchange_weak(current, bound,
+                                               std::memory_order_relaxed)) {
+    }
+    return current == 0;
+}
@@ -0,0 +1,91 @@
+#ifndef LEARNED_HEURISTIC_HPP
+#define LEARNED_HEURISTIC_HPP
+
+#include "board.hpp"
+#include "solution.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/// @brief LearnedHeuristic remembers lower bounds on the distance to the
+/// goal that earlier searches proved, so that later searches over the same
+/// region of the state space can use them through
+/// SearchOptions::learned_heuristic. Every search has the same goal, so a
+/// bound learned while solving one board holds for all of them.
+///
+/// Two kinds of bounds are learned from a search that found an optimal
+/// solution of length C*:
+///  - every state on the solution path, i moves from the start, is exactly
+///    C* - i moves from the goal;
+///  - every closed state with path cost g is at least C* - g moves from the
+///    goal, since no path through it can be shorter than C*. This is the
+///    update of Adaptive A*, and can be turned off.
+/// A state and its board::Reflect() image are equally far from the goal,
+/// so each bound is stored for both.
+///
+/// The table holds one byte for each of the board::kNumKeys states, so it
+/// never grows past 354 KiB however much is learned. Entries only go up,
+/// with relaxed atomic updates, so any number of threads can search with
+/// it and learn into it at once.
+class LearnedHeuristic {
+ public:
+    /// @brief Constructs a table that knows nothing yet.
+    /// @param learn_closed Whether to learn bounds from closed states as
+    /// well as from the solution path.
+    explicit LearnedHeuristic(bool learn_closed = true);
+
+    LearnedHeuristic(const LearnedHeuristic&) = delete;
+    LearnedHeuristic& operator=(const LearnedHeuristic&) = delete;
+
+    /// @brief Accesses the bound learned for a state.
+    /// @param key board::PackedKey() of the state.
+    /// @return Lower bound on its distance to the goal, 0 if unknown.
+    int Lookup(uint32_t key) const {
+        return values_[key].load(std::memory_order_relaxed);
+    }
+
+    /// @brief Records that a state is at least 'bound' moves from the goal,
+    /// as is its reflection. Lower bounds than the known ones are ignored.
+    /// @param state Packed state.
+    void LearnBound(uint64_t state, int bound);
+
+    /// @brief Records the exact distance of every state on an optimal
+    /// solution path.
+    /// @param start Packed start state of the search.
+    /// @param solution Found Solution of that search. It must be optimal.
+    void LearnPath(uint64_t start, const Solution& solution);
+
+    /// @brief Whether closed states should be learned from.
+    bool LearnClosed() const { return learn_closed_; }
+
+    /// @brief Adds one search's use of the table to the totals below.
+    /// Searches count locally and report once, so that they do not contend
+    /// on shared counters.
+    /// @param lookups States whose heuristic was looked up.
+    /// @param known Lookups that found a learned bound.
+    /// @param tightened Lookups whose bound beat the static heuristic.
+    void CountLookups(long long lookups, long long known,
+                      long long tightened);
+
+    long long Lookups() const { return lookups_.load(); }
+    long long Known() const { return known_.load(); }
+    long long Tightened() const { return tightened_.load(); }
+
+    /// @brief Accesses the number of states with a learned bound.
+    long long StatesLearned() const { return states_learned_.load(); }
+
+ private:
+    /// @brief Raises the bound of one key.
+    /// @return true if the key had no bound before.
+    bool Raise(uint32_t key, int bound);
+
+    bool learn_closed_;
+    std::unique_ptr<std::atomic<uint8_t>[]> values_;  // kNumKeys entries.
+    std::atomic<long long> lookups_;
+    std::atomic<long long> known_;
+    std::atomic<long long> tightened_;
+    std::atomic<long long> states_learned_;
+};
+
+#endif // LEARNED_HEURISTIC_HPP
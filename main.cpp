@@ -1,12 +1,140 @@
 #include "problem.hpp"
 #include "solver.hpp"
 #include "node.hpp"
+#include "solution.hpp"
+#include "server.hpp"
+#include "board.hpp"
+#include "batch_io.hpp"
+#include "search_handle.hpp"
+#include "solution_sink.hpp"
 #include <cctype>
-#include <stack>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+
+int main(int argc, char* argv[]) {
+    // Daemon mode: ./puzzle --serve <socket path> [number of workers]
+    //                         [--learn] [--memory]
+    if (argc >= 3 && std::strcmp(argv[1], "--serve") == 0) {
+        int workers = std::thread::hardware_concurrency();
+        bool learn = false;
+        bool log_memory = false;
+        for (int i = 3; i < argc; i++) {
+            char* end;
+            long number = std::strtol(argv[i], &end, 10);
+            if (std::strcmp(argv[i], "--learn") == 0) { learn = true; }
+            else if (std::strcmp(argv[i], "--memory") == 0) {
+                log_memory = true;
+            } else if (*argv[i] != '\0' && *end == '\0' && number > 0) {
+                workers = number;
+            } else {
+                std::cerr << "Usage: " << argv[0] << " --serve <socket path> "
+                    "[number of workers] [--learn] [--memory]" << std::endl;
+                return -1;
+            }
+        }
+        Server server(argv[2], workers, learn, log_memory);
+        return server.Run();
+    }
+
+    // --solve and --batch take a trailing --memory, which profiles each
+    // search and writes its peak memory by category to stderr.
+    bool log_memory = argc >= 4 &&
+        std::strcmp(argv[argc - 1], "--memory") == 0;
+    if (log_memory) {
+        argc--;
+    }
+
+    // One-shot mode: ./puzzle --solve <board> [algorithm] [format]
+    //                         [--memory]
+    // Prints the solution with a SolutionSink, by default the compact
+    // "<length> <moves> <nodes expanded>", and exits.
+    if (argc >= 3 && std::strcmp(argv[1], "--solve") == 0) {
+        std::vector<std::vector<int>> start;
+        if (!board::Parse(argv[2], &start)) {
+            std::cerr << "Invalid board: " << argv[2] << std::endl;
+            return -1;
+        }
+        Problem puzzle;
+        puzzle.Init(start);
+        Solver solve;
+        batch_io::BufferedWriter out(STDOUT_FILENO);
+        std::unique_ptr<SolutionSink> sink = MakeSolutionSink(
+            argc >= 5 ? argv[4] : "compact", &out, solve);
+        if (!sink) {
+            std::cerr << "Unknown format: " << argv[4] << std::endl;
+            return -1;
+        }
+        Solution result;
+        MemoryProfile profile;
+        SearchOptions options;
+        options.memory_profile = log_memory ? &profile : nullptr;
+        std::string algorithm = argc >= 4 ? argv[3] : "pdb";
+        if (solve.IsSolvable(puzzle) &&
+            !solve.Solve(puzzle, algorithm, options, &result)) {
+            std::cerr << "Unknown algorithm: " << algorithm << std::endl;
+            return -1;
+        }
+        if (!result.Found()) {
+            std::cerr << "No solution." << std::endl;
+            return -1;
+        }
+        if (log_memory) {
+            std::cerr << "Peak memory:\n" << profile.Summary();
+        }
+        sink->Write(puzzle, result);
+        return out.Flush() ? 0 : -1;
+    }
+
+    // Batch mode: ./puzzle --batch <board file> <solution file>
+    //                         [algorithm] [time limit ms] [--memory]
+    // Both files use the binary formats described in batch_io.hpp.
+    if (argc >= 4 && std::strcmp(argv[1], "--batch") == 0) {
+        batch_io::BoardFile boards;
+        std::string error;
+        if (!boards.Open(argv[2], &error)) {
+            std::cerr << argv[2] << ": " << error << std::endl;
+            return -1;
+        }
+        batch_io::RecordFileWriter records;
+        if (!records.Open(argv[3])) {
+            std::cerr << "Could not create " << argv[3] << std::endl;
+            return -1;
+        }
+        std::string algorithm = argc >= 5 ? argv[4] : "pdb";
+        SearchOptions options;
+        options.time_limit_ms = argc >= 6 ? std::atol(argv[5]) : 0;
+        Solver solve;
+        for (uint64_t i = 0; i < boards.Count(); i++) {
+            uint32_t key = boards.Key(i);
+            Problem puzzle;
+            puzzle.Init(board::FromKey(key));
+            Solution result;
+            MemoryProfile profile;
+            options.memory_profile = log_memory ? &profile : nullptr;
+            if (!solve.IsSolvable(puzzle)) {
+                records.Append(batch_io::MakeUnsolvableRecord(key));
+            } else if (solve.Solve(puzzle, algorithm, options, &result)) {
+                records.Append(batch_io::MakeRecord(key, result));
+                if (log_memory) {
+                    std::cerr << "Peak memory of board " << i << " (" <<
+                        board::Format(puzzle.GetStartPuzzle()) << "):\n" <<
+                        profile.Summary();
+                }
+            } else {
+                std::cerr << "Unknown algorithm: " << algorithm << std::endl;
+                return -1;
+            }
+        }
+        return records.Close() ? 0 : -1;
+    }
 
-int main() {
     Problem puzzle;
-    puzzle.Init();
+    if (!puzzle.Init()) {
+        return -1;  // Standard input ended before a puzzle was chosen.
+    }
 
     Solver solve;
     if (!solve.IsSolvable(puzzle)) {
@@ -17,68 +145,105 @@ int main() {
     std::cout << "\nEnter your choice of Algorithm\n" <<
             "(1) Uniform Cost Search\n" <<
             "(2) A* with the Misplaced Tile heuristic\n" <<
-            "(3) A* with the Euclidian Distance heuristic" <<
+            "(3) A* with the Euclidian Distance heuristic\n" <<
+            "(4) A* with the Manhattan Distance heuristic\n" <<
+            "(5) A* with the Pattern Database heuristic" <<
             std::endl;
 
     std::string input;
     int selection;
     do {
-        getline(std::cin, input);
-        selection = std::stoi(input);
+        if (!getline(std::cin, input)) {
+            return -1;
+        }
+        // Anything that is not a number reads as 0 and shows the menu again.
+        selection = std::atoi(input.c_str());
 
         switch (selection) {
             case 1: break;
             case 2: break;
             case 3: break;
+            case 4: break;
+            case 5: break;
             default: std::cout << "Type the number of your choice\n" <<
                     "(1) Uniform Cost Search\n" <<
                     "(2) A* with the Misplaced Tile Heuristic\n" <<
-                    "(3) A* with the Euclidian Distance heuristic" <<
+                    "(3) A* with the Euclidian Distance heuristic\n" <<
+                    "(4) A* with the Manhattan Distance heuristic\n" <<
+                    "(5) A* with the Pattern Database heuristic" <<
                     std::endl; break;
         }
-    } while (selection < 1 || selection > 3);
+    } while (selection < 1 || selection > 5);
 
     char debug;
     do {
         std::cout << "\nEnable live trace? Y or N: " << std::endl;
-        std::cin >> debug;
+        if (!(std::cin >> debug)) {
+            return -1;
+        }
         debug = std::tolower(debug);
     } while (debug != 'y' && debug != 'n');
 
     std::cout << "\nFinding solution..." << std::endl;
 
-    std::shared_ptr<Node> result;
+    Solution result;
+    MemoryProfile profile;  // Only filled in without the trace.
     if (debug == 'y') {
         switch (selection) {
             case 2: result = solve.AStarSearchTrace(puzzle, 0); break;
             case 3: result = solve.AStarSearchTrace(puzzle, 1); break;
+            case 4: result = solve.AStarSearchTrace(puzzle, 2); break;
+            case 5: result = solve.AStarSearchTrace(puzzle, 3); break;
             default: result = solve.UniformCostSearchTrace(puzzle); break;
         }
     } else {
-        switch (selection) {
-            case 2: result = solve.AStarSearch(puzzle, 0); break;
-            case 3: result = solve.AStarSearch(puzzle, 1); break;
-            default: result = solve.UniformCostSearch(puzzle); break;
+        const char* const kAlgorithms[] = {
+            "ucs", "misplaced", "euclidian", "manhattan", "pdb"
+        };
+        SearchOptions options;
+        options.progress_interval_ms = 500;
+        options.memory_profile = &profile;
+        SearchHandle search(solve, puzzle, kAlgorithms[selection - 1],
+                            options);
+        // Searches that take a while say how far along they are.
+        while (!search.WaitFor(1000)) {
+            SearchProgress progress = search.Progress();
+            std::cout << "Expanded " << progress.nodes_expanded <<
+                " node(s) so far, f = " << progress.f_bound << ", " <<
+                progress.open_size << " in the queue (" <<
+                static_cast<long>(progress.nodes_per_second) <<
+                " nodes/s)" << std::endl;
+        }
+        search.Wait(&result);
+    }
+
+    if (result.Found()) {
+        std::cout << "To solve this problem the search algorithm " <<
+            "expanded a total of " << result.GetNodesExpanded() <<
+            " node(s)." << std::endl;
+        std::cout << "The maximum number of nodes in the queue " <<
+            "at any one time: " << result.GetMaxFrontierSize() << std::endl;
+        if (profile.total_peak > 0) {
+            std::cout << "Peak memory of the search:\n" << profile.Summary();
         }
     }
 
     do {
         std::cout << "\nPrint solution? Y or N: " << std::endl;
-        std::cin >> debug;
+        if (!(std::cin >> debug)) {
+            return 0;  // The search itself succeeded.
+        }
         debug = std::tolower(debug);
     } while (debug != 'y' && debug != 'n');
 
-    if (debug == 'y') {
-        std::stack<std::shared_ptr<Node>> instructions;
-        while (result != nullptr) {
-            instructions.push(result);
-            result = result->GetParent();
-        }
-        while (!instructions.empty()) {
-            result = instructions.top();
-            std::cout << (*result) << std::endl;
-            instructions.pop();
-        }
+    if (debug == 'y' && result.Found()) {
+        // Boards are rebuilt one step at a time from the compact move list
+        // and written in large chunks.
+        std::cout.flush();
+        batch_io::BufferedWriter out(STDOUT_FILENO);
+        VerboseSink sink(&out, solve);
+        sink.Write(puzzle, result);
+        out.Flush();
     }
 
     std::cout << "\nDone!" << std::endl;
@@ -0,0 +1,67 @@
+#include "memory_stats.hpp"
+
+#include <cstdio>
+
+namespace {
+
+const char* const kCategoryNames[] = {
+    "open list", "closed set", "node storage", "move table",
+    "heuristic tables"
+};
+
+}  // namespace
+
+const char* MemoryCategoryName(MemoryCategory category) {
+    return kCategoryNames[category];
+}
+
+MemoryAccount::MemoryAccount() : total_live_(0), total_peak_(0) {
+    for (int i = 0; i < kMemoryCategories; i++) {
+        live_[i] = 0;
+        peak_[i] = 0;
+    }
+}
+
+void MemoryAccount::Allocate(MemoryCategory category, size_t bytes) {
+    live_[category] += bytes;
+    if (live_[category] > peak_[category]) {
+        peak_[category] = live_[category];
+    }
+    total_live_ += bytes;
+    if (total_live_ > total_peak_) {
+        total_peak_ = total_live_;
+    }
+}
+
+void MemoryAccount::Release(MemoryCategory category, size_t bytes) {
+    live_[category] -= bytes;
+    total_live_ -= bytes;
+}
+
+size_t MemoryAccount::TotalPeak() const {
+    return total_peak_;
+}
+
+size_t MemoryAccount::TotalLive() const {
+    return total_live_;
+}
+
+MemoryProfile::MemoryProfile() : total_peak(0) {
+    for (int i = 0; i < kMemoryCategories; i++) {
+        peak[i] = 0;
+    }
+}
+
+std::string MemoryProfile::Summary() const {
+    std::string summary;
+    char line[64];
+    for (int i = 0; i < kMemoryCategories; i++) {
+        std::snprintf(line, sizeof(line), "%-17s %10.1f KiB\n",
+                      kCategoryNames[i], peak[i] / 1024.0);
+        summary += line;
+    }
+    std::snprintf(line, sizeof(line), "%-17s %10.1f KiB\n", "total",
+                  total_peak / 1024.0);
+    summary += line;
+    return summary;
+}
@@ -0,0 +1,128 @@
+#ifndef MEMORY_STATS_HPP
+#define MEMORY_STATS_HPP
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+/// @brief What a block of search memory is used for.
+enum MemoryCategory {
+    kMemoryOpenList,         // Heap of OpenEntry waiting to be expanded.
+    kMemoryClosedSet,        // Hash index and closed flags of SearchSpace.
+    kMemoryNodeStorage,      // Per-node arrays of SearchSpace.
+    kMemoryMoveTable,        // MoveTable used to rebuild the path.
+    kMemoryHeuristicTables,  // Generated lookup tables, a fixed size.
+    kMemoryCategories
+};
+
+/// @brief Name of a MemoryCategory, for example "open list".
+const char* MemoryCategoryName(MemoryCategory category);
+
+/// @brief MemoryAccount keeps the live and peak bytes of each category for
+/// one search. It is only touched by the thread running that search, so the
+/// counters are plain integers.
+class MemoryAccount {
+ public:
+    MemoryAccount();
+
+    /// @brief Records that 'bytes' more are in use for 'category'.
+    void Allocate(MemoryCategory category, size_t bytes);
+
+    /// @brief Records that 'bytes' of 'category' were given back.
+    void Release(MemoryCategory category, size_t bytes);
+
+    size_t Live(MemoryCategory category) const { return live_[category]; }
+    size_t Peak(MemoryCategory category) const { return peak_[category]; }
+
+    /// @brief Accesses the largest sum of all categories at any one time.
+    size_t TotalPeak() const;
+
+    /// @brief Accesses the current sum of all categories.
+    size_t TotalLive() const;
+
+ private:
+    size_t live_[kMemoryCategories];
+    size_t peak_[kMemoryCategories];
+    size_t total_live_;
+    size_t total_peak_;
+};
+
+/// @brief Standard allocator that reports every allocation to a
+/// MemoryAccount under a fixed category. A default constructed one counts
+/// nothing, so containers keep working without an account.
+template <typename T>
+class CountingAllocator {
+ public:
+    typedef T value_type;
+
+    CountingAllocator() : account_(nullptr), category_(kMemoryNodeStorage) {}
+    CountingAllocator(MemoryAccount* account, MemoryCategory category)
+        : account_(account), category_(category) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other)
+        : account_(other.account()), category_(other.category()) {}
+
+    T* allocate(size_t n) {
+        if (account_ != nullptr) {
+            account_->Allocate(category_, n * sizeof(T));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (account_ != nullptr) {
+            account_->Release(category_, n * sizeof(T));
+        }
+        ::operator delete(p);
+    }
+
+    MemoryAccount* account() const { return account_; }
+    MemoryCategory category() const { return category_; }
+
+ private:
+    MemoryAccount* account_;
+    MemoryCategory category_;
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>& lhs,
+                const CountingAllocator<U>& rhs) {
+    return lhs.account() == rhs.account() &&
+        lhs.category() == rhs.category();
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>& lhs,
+                const CountingAllocator<U>& rhs) {
+    return !(lhs == rhs);
+}
+
+/// @brief std::vector whose memory can be counted by passing it a
+/// CountingAllocator.
+template <typename T>
+using CountedVector = std::vector<T, CountingAllocator<T> >;
+
+/// @brief Live bytes of every category at one point of a search.
+struct MemorySample {
+    int nodes_expanded;
+    double elapsed_seconds;
+    size_t live[kMemoryCategories];
+};
+
+/// @brief Memory use of one search: the peak of each category and a time
+/// series sampled every SearchOptions::memory_sample_interval expansions.
+/// Filled in when passed as SearchOptions::memory_profile.
+struct MemoryProfile {
+    MemoryProfile();
+
+    size_t peak[kMemoryCategories];
+    size_t total_peak;  // Peak of the sum, not the sum of the peaks.
+    std::vector<MemorySample> samples;
+
+    /// @brief Lists the peak of every category and the total, in KiB, one
+    /// per line.
+    std::string Summary() const;
+};
+
+#endif // MEMORY_STATS_HPP
@@ -7,20 +7,15 @@ Node::Node(const Problem& puzzle) {
     total_cost_ = path_cost_ + heuristic_;
 }
 
-Node::Node(const Problem& puzzle, std::shared_ptr<Node> parent,
+Node::Node(const Problem& puzzle, const Node& parent,
            const std::string& action) {
-    state_ = puzzle.ToState(parent->state_, action);
-    parent_ = parent;
+    state_ = puzzle.ToState(parent.state_, action);
     action_ = action;
-    path_cost_ = parent->path_cost_ + puzzle.ActionCost(parent->state_, action);
+    path_cost_ = parent.path_cost_ + puzzle.ActionCost(parent.state_, action);
     heuristic_ = 0;
     total_cost_ = path_cost_ + heuristic_;
 }
 
-std::shared_ptr<Node> Node::GetParent() const{
-    return parent_;
-}
-
 std::vector<std::vector<int>> Node::GetState() const{
     return state_;
 }
@@ -57,21 +52,21 @@ bool operator>(const Node& lhs, const Node& rhs) {
 }
 
 std::ostream& operator<<(std::ostream& os, const Node& node) {
-    os << "\n============================" << std::endl;
-    os << "Node Details" << std::endl;
-    os << "Puzzle State: " << std::endl;
+    os << "\n============================" << '\n';
+    os << "Node Details" << '\n';
+    os << "Puzzle State: " << '\n';
     for (int i = 0; i < node.state_.size(); i++) {
         os << "[ ";
         for (int j = 0; j < node.state_.at(i).size(); j++) {
             os << node.state_.at(i).at(j) << " ";
         }
-        os << "]" << std::endl;
+        os << "]" << '\n';
     }
     os << "Action to get here: " <<
-        (node.action_ == "" ? "None (start)" : node.action_) << std::endl;
-    os << "Path Cost: " << node.path_cost_ << std::endl;
-    os << "Heuristic Estimate: " << node.heuristic_ << std::endl;
-    os << "Total Cost: " << node.total_cost_ << std::endl;
+        (node.action_ == "" ? "None (start)" : node.action_) << '\n';
+    os << "Path Cost: " << node.path_cost_ << '\n';
+    os << "Heuristic Estimate: " << node.heuristic_ << '\n';
+    os << "Total Cost: " << node.total_cost_ << '\n';
     os << "============================";
     return os;
 }
\ No newline at end of file
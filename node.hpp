@@ -6,14 +6,14 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <memory>
 
 /// @brief Nodes are the tools used to construct a search graph that allows
 /// us to find a solution from the root Node to the goal state. It is important
 /// that a Node's path cost, heuristic, and total cost values are initialized
 /// since the tools in Solver rely on those values to perform calculations.
-/// The reason we store a shared pointer is because many Nodes can have the
-/// same parent so a unique pointer would not be helpful.
+/// A Node does not keep its parent alive. Solver records the action that
+/// reached each closed state in a MoveTable instead, and rebuilds the path
+/// from there once the goal is found.
 class Node {
  public:
     /// @brief Constructs a Node to be used as the root of the search graph.
@@ -23,18 +23,13 @@ class Node {
     /// @brief Constructs a Node to be used as a child of another Node.
     /// @param puzzle Fully initialized Puzzle object used to set this Node's
     /// state by performing an action on the parent Node's state.
-    /// @param parent A root or child Node pointer that is stored in this
-    /// Node and is used to print the solution path.
+    /// @param parent A root or child Node whose state and path cost the
+    /// new Node is derived from. It is not referenced afterwards.
     /// @param action String representing the action performed to get
     /// to this Node's state.
-    Node(const Problem& puzzle, std::shared_ptr<Node> parent,
+    Node(const Problem& puzzle, const Node& parent,
          const std::string& action);
 
-    /// @brief Accesses this Node's parent Node.
-    /// @return Shared pointer to this Node's parent. Null if this Node
-    /// is the root node.
-    std::shared_ptr<Node> GetParent() const;
-
     /// @brief Accesses this Node's puzzle state.
     /// @return 2D vector representing this Node's current state.
     std::vector<std::vector<int>> GetState() const;
@@ -70,11 +65,11 @@ class Node {
     friend bool operator>(const Node& lhs, const Node& rhs);
 
     /// @brief Prints a Node's state, action that led to it, the path
-    /// cost, heuristic, and total cost.
+    /// cost, heuristic, and total cost. Lines end in '\n' and the stream
+    /// is not flushed.
     friend std::ostream& operator<<(std::ostream& os, const Node& node);
 
  private:
-    std::shared_ptr<Node> parent_;
     std::vector<std::vector<int>> state_;
     std::string action_;  // Action taken from parent to reach this Node.
     int path_cost_;  // Distance from the root Node.
@@ -1,24 +1,59 @@
 #include "problem.hpp"
 
-void Problem::Init() {
+#include <cstdlib>
+
+namespace {
+
+// Reads a line of standard input. No answer can follow the end of the
+// input, so it fails there and the prompts give up instead of asking
+// forever.
+bool ReadLine(std::string* line) {
+    return static_cast<bool>(std::getline(std::cin, *line));
+}
+
+// Reads a menu choice. Anything that is not a number reads as 0, which no
+// menu accepts, so the menu is shown again.
+bool ReadChoice(int* choice) {
+    std::string line;
+    if (!ReadLine(&line)) {
+        return false;
+    }
+    *choice = std::atoi(line.c_str());
+    return true;
+}
+
+}  // namespace
+
+bool Problem::Init() {
     std::cout << "\nWelcome to Sergio's 8 puzzle solver.\n" <<
         "Type \"1\" to use a default puzzle, or \"2\" to" <<
         " enter your own puzzle." << std::endl;
 
-    std::string input;
     int selection;
+    bool chosen = false;
     do {
-        getline(std::cin, input);
-        selection = std::stoi(input);
+        if (!ReadChoice(&selection)) {
+            return false;
+        }
 
         switch (selection) {
-            case 1: initial_state_ = ChooseDefaultPuzzle(); break;
-            case 2: initial_state_ = MakeCustomPuzzle(); break;
+            case 1: chosen = ChooseDefaultPuzzle(&initial_state_); break;
+            case 2: chosen = MakeCustomPuzzle(&initial_state_); break;
             default: std::cout << "Enter \"1\" for a default puzzle " <<
                         "or \"2\" to enter your own puzzle." <<
                         std::endl; break;
         }
     } while (selection < 1 || selection > 2);
+    if (!chosen) {
+        return false;
+    }
+
+    Init(initial_state_);
+    return true;
+}
+
+void Problem::Init(const std::vector<std::vector<int>>& start) {
+    initial_state_ = start;
 
     std::vector<std::vector<int>> end_matrix = {
             {1, 2, 3},
@@ -34,6 +69,10 @@ std::vector<std::vector<int>> Problem::GetStartPuzzle() const {
     return initial_state_;
 }
 
+std::vector<std::vector<int>> Problem::GetGoalState() const {
+    return goal_state_;
+}
+
 std::vector<std::string> Problem::GetActions() const {
     return actions_;
 }
@@ -109,7 +148,7 @@ void Problem::PrintPuzzleState(
     }
 }
 
-std::vector<std::vector<int>> Problem::ChooseDefaultPuzzle() {
+bool Problem::ChooseDefaultPuzzle(std::vector<std::vector<int>>* puzzle) {
     std::vector<std::vector<int>> trivial = {
             {1, 2, 3},
             {4, 5, 6},
@@ -134,7 +173,6 @@ std::vector<std::vector<int>> Problem::ChooseDefaultPuzzle() {
             {1, 2, 3},
             {4, 5, 6},
             {8, 7, 0}};
-    std::string input;
     int selection;
 
     std::cout << "\nChoose the level of difficulty:\n" <<
@@ -142,45 +180,67 @@ std::vector<std::vector<int>> Problem::ChooseDefaultPuzzle() {
         "(4) Doable (5) Oh Boy (6) Impossible" <<
         std::endl;
     do {
-        getline(std::cin, input);
-        selection = std::stoi(input);
+        if (!ReadChoice(&selection)) {
+            return false;
+        }
         switch (selection) {
-            case 1: return trivial;
-            case 2: return veryEasy;
-            case 3: return easy;
-            case 4: return doable;
-            case 5: return ohBoy;
-            case 6: return noChance;
+            case 1: *puzzle = trivial; break;
+            case 2: *puzzle = veryEasy; break;
+            case 3: *puzzle = easy; break;
+            case 4: *puzzle = doable; break;
+            case 5: *puzzle = ohBoy; break;
+            case 6: *puzzle = noChance; break;
             default: std::cout << "Enter a value between 1-6" <<
                             std::endl; break;
         }
     } while (selection < 1 || selection > 6);
-    // Shouldn't reach here
-    return easy;
+    return true;
 }
 
-std::vector<std::vector<int>> Problem::MakeCustomPuzzle() {
-    std::vector<std::vector<int>> puzzle;
-    std::string row;
+bool Problem::MakeCustomPuzzle(std::vector<std::vector<int>>* puzzle) {
     std::vector<std::string> messages = {
         "\nEnter your puzzle, use a zero to represent the blank\nEnter the first row, use space or tabs between numbers:  ",
         "Enter the second row, use space or tabs between numbers:  ",
         "Enter the third row, use space or tabs between numbers:  "
     };
-    for (int i = 0; i < messages.size(); i++) {
-        std::cout << messages.at(i);
-        getline(std::cin, row);
-        puzzle.push_back(ParseCustomInput(row));
+    for (;;) {
+        std::vector<std::vector<int>> rows;
+        bool seen[9] = { false };
+        bool valid = true;
+        for (int i = 0; i < messages.size() && valid; i++) {
+            std::cout << messages.at(i);
+            std::string line;
+            if (!ReadLine(&line)) {
+                return false;
+            }
+            std::vector<int> row;
+            valid = ParseCustomInput(line, &row) && row.size() == 3;
+            for (size_t j = 0; valid && j < row.size(); j++) {
+                valid = !seen[row.at(j)];
+                seen[row.at(j)] = true;
+            }
+            rows.push_back(row);
+        }
+        if (valid) {
+            *puzzle = rows;
+            return true;
+        }
+        std::cout << "\nEach row needs three numbers, and each number " <<
+            "from 0 to 8 must appear once." << std::endl;
     }
-    return puzzle;
 }
 
-std::vector<int> Problem::ParseCustomInput(const std::string& input) {
-    std::vector<int> row;
-    std::string numbers;
+bool Problem::ParseCustomInput(const std::string& input,
+                               std::vector<int>* row) {
+    std::vector<int> numbers;
+    std::string number;
     std::istringstream iss(input);  // Parses around whitespace
-    while (iss >> numbers) {
-        row.push_back(std::stoi(numbers));
+    while (iss >> number) {
+        if (number.size() != 1 || number[0] < '0' || number[0] > '8') {
+            return false;
+        }
+        numbers.push_back(number[0] - '0');
     }
-    return row;
+    *row = numbers;
+    return true;
 }
\ No newline at end of file
@@ -14,12 +14,23 @@ class Problem {
 
     /// @brief Intializes a Problem instance by setting the starting puzzle
     /// configuration, the goal, and available actions.
-    void Init();
+    /// @return false if standard input ended before a puzzle was chosen.
+    bool Init();
+
+    /// @brief Intializes a Problem instance without prompting the user.
+    /// Used by the server, where the starting configuration arrives with
+    /// each request.
+    /// @param start 2D vector representing the starting configuration.
+    void Init(const std::vector<std::vector<int>>& start);
 
     /// @brief Get this problem's starting puzzle configuration.
     /// @return 2D vector representing the starting configuration.
     std::vector<std::vector<int>> GetStartPuzzle() const;
 
+    /// @brief Get this problem's goal configuration.
+    /// @return 2D vector representing the goal state.
+    std::vector<std::vector<int>> GetGoalState() const;
+
     /// @brief Get this problem's available actions.
     /// @return Vector of the available actions: "UP", "DOWN", "LEFT", "RIGHT".
     std::vector<std::string> GetActions() const;
@@ -50,6 +61,15 @@ class Problem {
     /// @param state Current puzzle state.
     void PrintPuzzleState(const std::vector<std::vector<int>>& state) const;
 
+    /// @brief Extracts the numbers from a user-supplied string and adds
+    /// them to a vector.
+    /// @param input String of numbers separated by whitespace.
+    /// @param row Receives a row of an 8-Puzzle. Left alone on failure.
+    /// @return false if any word of 'input' is not a tile number from 0 to
+    /// 8.
+    static bool ParseCustomInput(const std::string& input,
+                                 std::vector<int>* row);
+
  private:
     std::vector<std::vector<int>> initial_state_;
     std::vector<std::vector<int>> goal_state_;
@@ -57,17 +77,14 @@ class Problem {
 
     /// @brief Prompts the user to choose a pre-configured
     /// puzzle out of 1-6 (inclusive) options.
-    /// @return 2D vector representing a pre-configured puzzle.
-    std::vector<std::vector<int>> ChooseDefaultPuzzle();
-
-    /// @brief Creates a custom puzzle configuration based on the user's input.
-    /// @return 2D vector representing a user-made puzzle.
-    std::vector<std::vector<int>> MakeCustomPuzzle();
+    /// @param puzzle Receives the 2D vector of a pre-configured puzzle.
+    /// @return false if standard input ended before a choice was made.
+    bool ChooseDefaultPuzzle(std::vector<std::vector<int>>* puzzle);
 
-    /// @brief Extracts the numbers from a user-supplied string and adds
-    /// them to a vector.
-    /// @param input String of numbers separated by whitespace.
-    /// @return A vector that represents a row in an 8-Puzzle.
-    std::vector<int> ParseCustomInput(const std::string& input);
+    /// @brief Creates a custom puzzle configuration based on the user's
+    /// input. Asks again until the rows hold each tile from 0 to 8 once.
+    /// @param puzzle Receives the 2D vector of a user-made puzzle.
+    /// @return false if standard input ended before a valid puzzle.
+    bool MakeCustomPuzzle(std::vector<std::vector<int>>* puzzle);
 };
 #endif // PROBLEM_HPP
\ No newline at end of file
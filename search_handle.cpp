@@ -0,0 +1,67 @@
+#include "search_handle.hpp"
+
+#include <chrono>
+
+SearchHandle::SearchHandle(const Solver& solver, const Problem& puzzle,
+                           const std::string& algorithm,
+                           const SearchOptions& options)
+    : cancel_(false), done_(false), known_algorithm_(false),
+      thread_(&SearchHandle::Run, this, std::cref(solver), puzzle, algorithm,
+              options) {}
+
+SearchHandle::~SearchHandle() {
+    Cancel();
+    thread_.join();
+}
+
+void SearchHandle::Cancel() {
+    cancel_.store(true, std::memory_order_relaxed);
+}
+
+SearchProgress SearchHandle::Progress() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return progress_;
+}
+
+bool SearchHandle::Done() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_;
+}
+
+bool SearchHandle::WaitFor(long timeout_ms) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return finished_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                              [this] { return done_; });
+}
+
+bool SearchHandle::Wait(Solution* solution) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finished_.wait(lock, [this] { return done_; });
+    *solution = solution_;
+    return known_algorithm_;
+}
+
+void SearchHandle::Run(const Solver& solver, const Problem& puzzle,
+                       const std::string& algorithm, SearchOptions options) {
+    std::function<void(const SearchProgress&)> forward = options.progress;
+    options.cancel = &cancel_;
+    options.progress = [this, forward](const SearchProgress& progress) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            progress_ = progress;
+        }
+        if (forward) {
+            forward(progress);
+        }
+    };
+
+    Solution solution;
+    bool known_algorithm = solver.Solve(puzzle, algorithm, options, &solution);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        solution_ = solution;
+        known_algorithm_ = known_algorithm;
+        done_ = true;
+    }
+    finished_.notify_all();
+}
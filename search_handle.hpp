@@ -0,0 +1,80 @@
+#ifndef SEARCH_HANDLE_HPP
+#define SEARCH_HANDLE_HPP
+
+#include "problem.hpp"
+#include "solution.hpp"
+#include "solver.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// @brief SearchHandle runs one Solver::Solve() call on a thread of its own,
+/// so the caller can keep working, watch the search's progress and stop it
+/// early. The search checks its cancel flag and deadline every few hundred
+/// expansions, so Cancel() takes effect within microseconds.
+///
+///     SearchHandle search(solver, puzzle, "pdb", SearchOptions());
+///     while (!search.WaitFor(100)) {
+///         std::cout << search.Progress().nodes_expanded << std::endl;
+///     }
+///     Solution solution;
+///     search.Wait(&solution);
+class SearchHandle {
+ public:
+    /// @brief Starts the search right away.
+    /// @param solver Solver to run. Must outlive the handle.
+    /// @param puzzle Fully initialized Puzzle instance. It is copied.
+    /// @param algorithm Any name accepted by Solver::Solve().
+    /// @param options Limits applied to the search. options.cancel is
+    /// replaced by the handle's own flag, and options.progress, if set, is
+    /// still called from the searching thread.
+    SearchHandle(const Solver& solver, const Problem& puzzle,
+                 const std::string& algorithm, const SearchOptions& options);
+
+    /// @brief Cancels the search if it is still running and waits for it.
+    ~SearchHandle();
+
+    SearchHandle(const SearchHandle&) = delete;
+    SearchHandle& operator=(const SearchHandle&) = delete;
+
+    /// @brief Asks the search to stop. It then ends with status kCancelled,
+    /// unless it had already finished.
+    void Cancel();
+
+    /// @brief Accesses the latest progress report. Reports are taken every
+    /// options.progress_interval_ms, so this is all zeros at first.
+    SearchProgress Progress() const;
+
+    /// @brief Checks whether the search has finished, without blocking.
+    bool Done() const;
+
+    /// @brief Blocks until the search finishes or 'timeout_ms' elapses.
+    /// @return true if the search has finished.
+    bool WaitFor(long timeout_ms) const;
+
+    /// @brief Blocks until the search finishes.
+    /// @param solution Receives the result of the search.
+    /// @return false if 'algorithm' was not a name Solver::Solve() accepts.
+    bool Wait(Solution* solution) const;
+
+ private:
+    /// @brief Body of the searching thread.
+    void Run(const Solver& solver, const Problem& puzzle,
+             const std::string& algorithm, SearchOptions options);
+
+    std::atomic<bool> cancel_;
+
+    mutable std::mutex mutex_;  // Guards everything below.
+    mutable std::condition_variable finished_;
+    SearchProgress progress_;
+    bool done_;
+    bool known_algorithm_;
+    Solution solution_;
+
+    std::thread thread_;  // Started last, once the members above exist.
+};
+
+#endif // SEARCH_HANDLE_HPP
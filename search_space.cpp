@@ -0,0 +1,116 @@
+#include "search_space.hpp"
+
+namespace {
+
+const uint32_t kInitialSlots = 1024;
+
+uint32_t Hash(uint32_t key) {
+    return key * 2654435761u;  // Knuth's multiplicative hash.
+}
+
+}  // namespace
+
+SearchSpace::SearchSpace(MemoryAccount* account)
+    : mask_(kInitialSlots - 1), account_(account), node_bytes_(0),
+      index_bytes_(0) {
+    Slot empty = { kNone, 0 };
+    slots_.assign(kInitialSlots, empty);
+    if (account_ != nullptr) {
+        Account();
+    }
+}
+
+SearchSpace::~SearchSpace() {
+    if (account_ != nullptr) {
+        account_->Release(kMemoryNodeStorage, node_bytes_);
+        account_->Release(kMemoryClosedSet, index_bytes_);
+    }
+}
+
+uint32_t SearchSpace::Add(uint64_t state, uint32_t key, int path_cost,
+                          float heuristic, uint8_t move) {
+    uint32_t index = states_.size();
+    // The arrays grow in step, so they all reallocate when this one does.
+    bool reallocating = states_.size() == states_.capacity();
+    states_.push_back(state);
+    keys_.push_back(key);
+    path_costs_.push_back(path_cost);
+    heuristics_.push_back(heuristic);
+    moves_.push_back(move);
+    closed_.push_back(0);
+    if (reallocating && account_ != nullptr) {
+        Account();
+    }
+
+    if (2 * states_.size() > slots_.size()) {
+        Grow();  // Reinserts the new node too.
+    } else {
+        uint32_t slot = Hash(key) & mask_;
+        while (slots_[slot].key != kNone) {
+            slot = (slot + 1) & mask_;
+        }
+        slots_[slot].key = key;
+        slots_[slot].index = index;
+    }
+    return index;
+}
+
+uint32_t SearchSpace::Find(uint32_t key) const {
+    uint32_t slot = Hash(key) & mask_;
+    while (slots_[slot].key != kNone) {
+        if (slots_[slot].key == key) {
+            return slots_[slot].index;
+        }
+        slot = (slot + 1) & mask_;
+    }
+    return kNone;
+}
+
+void SearchSpace::Update(uint32_t i, int path_cost, uint8_t move) {
+    path_costs_[i] = path_cost;
+    moves_[i] = move;
+}
+
+void SearchSpace::Close(uint32_t i) {
+    closed_[i] = 1;
+}
+
+void SearchSpace::Reopen(uint32_t i) {
+    closed_[i] = 0;
+}
+
+uint32_t SearchSpace::Size() const {
+    return states_.size();
+}
+
+void SearchSpace::Grow() {
+    Slot empty = { kNone, 0 };
+    slots_.assign(slots_.size() * 2, empty);
+    if (account_ != nullptr) {
+        Account();
+    }
+    mask_ = slots_.size() - 1;
+    for (uint32_t i = 0; i < keys_.size(); i++) {
+        uint32_t slot = Hash(keys_[i]) & mask_;
+        while (slots_[slot].key != kNone) {
+            slot = (slot + 1) & mask_;
+        }
+        slots_[slot].key = keys_[i];
+        slots_[slot].index = i;
+    }
+}
+
+void SearchSpace::Account() {
+    size_t node_bytes = states_.capacity() * sizeof(uint64_t) +
+        keys_.capacity() * sizeof(uint32_t) + path_costs_.capacity() +
+        heuristics_.capacity() * sizeof(float) + moves_.capacity();
+    size_t index_bytes = slots_.capacity() * sizeof(Slot) + closed_.capacity();
+    // Counting the new size before releasing the old one matches a
+    // reallocation, where both arrays are briefly alive.
+    account_->Allocate(kMemoryNodeStorage, node_bytes);
+    account_->Release(kMemoryNodeStorage, node_bytes_);
+    account_->Allocate(kMemoryClosedSet, index_bytes);
+    account_->Release(kMemoryClosedSet, index_bytes_);
+    node_bytes_ = node_bytes;
+    index_bytes_ = index_bytes;
+}
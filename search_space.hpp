@@ -0,0 +1,131 @@
+#ifndef SEARCH_SPACE_HPP
+#define SEARCH_SPACE_HPP
+
+#include "board.hpp"
+#include "memory_stats.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+/// @brief SearchSpace stores every node one search generates as a structure
+/// of arrays: the packed state, key, path cost, heuristic and move of node
+/// i sit at index i of separate contiguous vectors. Nodes are referred to by
+/// that 32-bit index instead of a pointer, and a node's state is found again
+/// through an open addressing hash index keyed by board::ToKey().
+///
+/// There is no parent index: the path is rebuilt from the MoveTable once
+/// the goal is reached, so nodes only remember the move that reached them.
+class SearchSpace {
+ public:
+    /// @brief Find() result when the state has never been generated.
+    static const uint32_t kNone = 0xFFFFFFFF;
+
+    /// @brief Move() of the root node.
+    static const uint8_t kNoMove = 0xFF;
+
+    /// @brief Creates an empty search space.
+    /// @param account If not null, receives the bytes held by the node
+    /// arrays (node storage) and by the hash index and closed flags (closed
+    /// set), counted by capacity whenever they grow.
+    explicit SearchSpace(MemoryAccount* account = nullptr);
+    ~SearchSpace();
+
+    SearchSpace(const SearchSpace&) = delete;
+    SearchSpace& operator=(const SearchSpace&) = delete;
+
+    /// @brief Stores a newly generated node. It starts out open.
+    /// @param state Packed state.
+    /// @param key board::PackedKey() of 'state'.
+    /// @param path_cost Distance from the root node.
+    /// @param heuristic Estimated distance to the goal.
+    /// @param move board::Move that reached the node, or kNoMove.
+    /// @return Index of the new node.
+    uint32_t Add(uint64_t state, uint32_t key, int path_cost, float heuristic,
+                 uint8_t move);
+
+    /// @brief Looks up the node that holds a state.
+    /// @param key board::PackedKey() of the state.
+    /// @return Index of the node, or kNone.
+    uint32_t Find(uint32_t key) const;
+
+    /// @brief Records a cheaper path to an open node.
+    void Update(uint32_t i, int path_cost, uint8_t move);
+
+    /// @brief Moves a node from the open list to the closed list.
+    void Close(uint32_t i);
+
+    /// @brief Moves a closed node back to the open list.
+    void Reopen(uint32_t i);
+
+    uint64_t State(uint32_t i) const { return states_[i]; }
+    uint32_t Key(uint32_t i) const { return keys_[i]; }
+    int PathCost(uint32_t i) const { return path_costs_[i]; }
+    float Heuristic(uint32_t i) const { return heuristics_[i]; }
+    float TotalCost(uint32_t i) const { return path_costs_[i] + heuristics_[i]; }
+    uint8_t Move(uint32_t i) const { return moves_[i]; }
+    bool IsClosed(uint32_t i) const { return closed_[i] != 0; }
+
+    /// @brief Accesses the number of nodes stored.
+    uint32_t Size() const;
+
+ private:
+    /// @brief One hash index slot. 'key' is kNone when the slot is empty.
+    struct Slot {
+        uint32_t key;
+        uint32_t index;
+    };
+
+    /// @brief Doubles the hash index and reinserts every node.
+    void Grow();
+
+    /// @brief Reports the change in capacity of the arrays to account_.
+    void Account();
+
+    std::vector<uint64_t> states_;
+    std::vector<uint32_t> keys_;
+    std::vector<uint8_t> path_costs_;  // At most 31 on the 8-puzzle.
+    std::vector<float> heuristics_;
+    std::vector<uint8_t> moves_;
+    std::vector<uint8_t> closed_;
+
+    std::vector<Slot> slots_;  // Power of two size, at most half full.
+    uint32_t mask_;
+
+    // The arrays are counted here rather than through CountingAllocator,
+    // whose extra allocator_traits call per push_back() made unoptimized
+    // builds about 10% slower even with no account.
+    MemoryAccount* account_;
+    size_t node_bytes_;   // Last reported to account_.
+    size_t index_bytes_;
+};
+
+/// @brief Entry of the open list: just a node's total cost, tie-breaking
+/// key and index, so a comparison reads 12 contiguous bytes and never
+/// touches the node itself.
+struct OpenEntry {
+    float total_cost;
+    uint32_t tie;  // Among equal total costs, the lowest is expanded first.
+    uint32_t index;
+};
+
+/// @brief Orders OpenEntry so that std::priority_queue yields the lowest
+/// total cost first, and the lowest 'tie' among equal costs.
+struct OpenEntryOrder {
+    bool operator()(const OpenEntry& lhs, const OpenEntry& rhs) const {
+        if (lhs.total_cost != rhs.total_cost) {
+            return lhs.total_cost > rhs.total_cost;
+        }
+        return lhs.tie > rhs.tie;
+    }
+};
+
+/// @brief The open list is a binary heap of OpenEntry. A node whose cost
+/// drops is pushed again and the outdated entry is skipped when it surfaces.
+/// Build it as OpenList(OpenEntryOrder(), OpenEntries(allocator)) to count
+/// its memory.
+typedef CountedVector<OpenEntry> OpenEntries;
+typedef std::priority_queue<OpenEntry, OpenEntries, OpenEntryOrder> OpenList;
+
+#endif // SEARCH_SPACE_HPP
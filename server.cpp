@@ -0,0 +1,394 @@
+#include "server.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <set>
+#include <sstream>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+// epoll user data for the fixed descriptors. Clients are numbered after.
+const uint64_t kListenId = 0;
+const uint64_t kWakeId = 1;
+const uint64_t kSignalId = 2;
+const uint64_t kFirstClientId = 3;
+
+// Longest request line accepted before the client is dropped.
+const size_t kMaxLineLength = 1024;
+
+bool AddToEpoll(int epoll_fd, int fd, uint32_t events, uint64_t id) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = events;
+    event.data.u64 = id;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+}  // namespace
+
+Server::Server(const std::string& socket_path, int num_workers, bool learn,
+               bool log_memory)
+    : socket_path_(socket_path), num_workers_(num_workers), epoll_fd_(-1),
+      listen_fd_(-1), wake_fd_(-1), signal_fd_(-1),
+      learned_(learn ? new LearnedHeuristic() : nullptr),
+      log_memory_(log_memory),
+      next_id_(kFirstClientId), stopping_(false) {
+    if (num_workers_ < 1) {
+        num_workers_ = 1;
+    }
+}
+
+int Server::Run() {
+    // Block the shutdown signals before any worker exists so that every
+    // thread inherits the mask and they are only seen through signal_fd_.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path_.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << socket_path_ << std::endl;
+        return -1;
+    }
+    std::strcpy(address.sun_path, socket_path_.c_str());
+    unlink(socket_path_.c_str());
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                        0);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    signal_fd_ = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (listen_fd_ < 0 || wake_fd_ < 0 || signal_fd_ < 0 || epoll_fd_ < 0 ||
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+        listen(listen_fd_, SOMAXCONN) != 0 ||
+        !AddToEpoll(epoll_fd_, listen_fd_, EPOLLIN, kListenId) ||
+        !AddToEpoll(epoll_fd_, wake_fd_, EPOLLIN, kWakeId) ||
+        !AddToEpoll(epoll_fd_, signal_fd_, EPOLLIN, kSignalId)) {
+        std::cerr << "Could not listen on " << socket_path_ << ": " <<
+            std::strerror(errno) << std::endl;
+        return -1;
+    }
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < num_workers_; i++) {
+        workers.push_back(std::thread(&Server::WorkerLoop, this));
+    }
+    std::cout << "Listening on " << socket_path_ << " with " <<
+        num_workers_ << " worker(s)." << std::endl;
+
+    bool running = true;
+    epoll_event events[64];
+    while (running) {
+        int ready = epoll_wait(epoll_fd_, events, 64, -1);
+        if (ready < 0) {
+            if (errno == EINTR) { continue; }
+            break;
+        }
+        for (int i = 0; i < ready; i++) {
+            uint64_t id = events[i].data.u64;
+            if (id == kListenId) {
+                int fd;
+                while ((fd = accept4(listen_fd_, nullptr, nullptr,
+                                     SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    Connection connection;
+                    connection.fd = fd;
+                    connection.pending = 0;
+                    connection.want_write = false;
+                    connection.read_closed = false;
+                    connection.cancel =
+                        std::make_shared<std::atomic<bool>>(false);
+                    uint64_t client = next_id_++;
+                    if (AddToEpoll(epoll_fd_, fd, EPOLLIN, client)) {
+                        connections_[client] = connection;
+                    } else {
+                        close(fd);
+                    }
+                }
+            } else if (id == kWakeId) {
+                uint64_t count;
+                while (read(wake_fd_, &count, sizeof(count)) > 0) {}
+                DeliverResults();
+            } else if (id == kSignalId) {
+                running = false;
+            } else {
+                std::map<uint64_t, Connection>::iterator it =
+                    connections_.find(id);
+                if (it == connections_.end()) { continue; }
+                Connection& connection = it->second;
+                // A hung up client cannot receive its responses anymore.
+                bool alive = !(events[i].events & (EPOLLHUP | EPOLLERR));
+                if (alive && (events[i].events & EPOLLIN)) {
+                    alive = ReadFrom(id, connection);
+                }
+                if (alive && (events[i].events & EPOLLOUT)) {
+                    alive = FlushTo(id, connection);
+                }
+                if (!alive || (connection.read_closed &&
+                               connection.pending == 0 &&
+                               connection.out.empty())) {
+                    Drop(id);
+                }
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        jobs_.clear();
+    }
+    has_jobs_.notify_all();
+    for (const std::pair<const uint64_t, Connection>& entry : connections_) {
+        entry.second.cancel->store(true);  // Cuts running searches short.
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    while (!connections_.empty()) {
+        Drop(connections_.begin()->first);
+    }
+    close(epoll_fd_);
+    close(signal_fd_);
+    close(wake_fd_);
+    close(listen_fd_);
+    unlink(socket_path_.c_str());
+    if (!largest_request_.empty()) {
+        std::cout << "Peak memory of the largest search (" <<
+            largest_request_ << "):\n" << largest_profile_.Summary();
+    }
+    if (learned_) {
+        std::cout << "Learned bounds for " << learned_->StatesLearned() <<
+            " states; " << learned_->Known() << " of " <<
+            learned_->Lookups() << " lookups found one." << std::endl;
+    }
+    std::cout << "Server stopped." << std::endl;
+    return 0;
+}
+
+void Server::WorkerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!stopping_ && jobs_.empty()) {
+                has_jobs_.wait(lock);
+            }
+            if (stopping_) { return; }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        MemoryProfile profile;
+        std::string request = job.line;
+        job.line = Handle(job, &profile);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            results_.push_back(std::move(job));
+            if (log_memory_ && profile.total_peak > 0) {
+                std::cout << "Peak memory of " << request << ":\n" <<
+                    profile.Summary() << std::flush;
+            }
+            if (profile.total_peak > largest_profile_.total_peak) {
+                largest_profile_ = std::move(profile);
+                largest_profile_.samples.clear();  // Only the peaks are shown.
+                largest_request_ = std::move(request);
+            }
+        }
+        uint64_t one = 1;
+        if (write(wake_fd_, &one, sizeof(one)) < 0) {
+            // The counter can only overflow if the loop has stopped reading.
+        }
+    }
+}
+
+std::string Server::Handle(const Job& job, MemoryProfile* profile) const {
+    std::istringstream iss(job.line);
+    std::string id;
+    std::string algorithm;
+    long time_limit_ms;
+    std::string board_text;
+    if (!(iss >> id >> algorithm >> time_limit_ms >> board_text)) {
+        return (id.empty() ? "?" : id) + " ERROR malformed request\n";
+    }
+
+    std::vector<std::vector<int>> start;
+    if (!board::Parse(board_text, &start)) {
+        return id + " ERROR invalid board\n";
+    }
+    Problem puzzle;
+    puzzle.Init(start);
+    if (!solver_.IsSolvable(puzzle)) {
+        return id + " UNSOLVABLE\n";
+    }
+
+    SearchOptions options;
+    if (time_limit_ms > 0) {
+        options.deadline = job.received +
+            std::chrono::milliseconds(time_limit_ms);
+    }
+    options.cancel = job.cancel.get();
+    options.memory_profile = profile;
+    options.learned_heuristic = learned_.get();
+    Solution solution;
+    if (!solver_.Solve(puzzle, algorithm, options, &solution)) {
+        return id + " ERROR unknown algorithm\n";
+    }
+
+    std::ostringstream response;
+    response << id;
+    switch (solution.GetStatus()) {
+        case Solution::kFound:
+            response << " OK " << solution.Length() << " " <<
+                (solution.Length() ? solution.MoveString() : "-") << " " <<
+                solution.GetNodesExpanded();
+            break;
+        case Solution::kExhausted:
+            response << " EXHAUSTED " << solution.GetNodesExpanded();
+            break;
+        case Solution::kTimedOut:
+            response << " TIMEOUT " << solution.GetNodesExpanded();
+            break;
+        case Solution::kCancelled:
+            // Nobody is left to read this.
+            response << " CANCELLED " << solution.GetNodesExpanded();
+            break;
+    }
+    response << "\n";
+    return response.str();
+}
+
+bool Server::ReadFrom(uint64_t id, Connection& connection) {
+    char buffer[4096];
+    for (;;) {
+        ssize_t count = read(connection.fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            connection.in.append(buffer, count);
+        } else if (count == 0) {
+            connection.read_closed = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            return false;
+        }
+    }
+
+    std::vector<Job> batch;
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    size_t begin = 0;
+    size_t end;
+    while ((end = connection.in.find('\n', begin)) != std::string::npos) {
+        Job job;
+        job.connection = id;
+        job.received = now;
+        job.cancel = connection.cancel;
+        job.line = connection.in.substr(begin, end - begin);
+        if (!job.line.empty() && job.line.back() == '\r') {
+            job.line.pop_back();
+        }
+        if (!job.line.empty()) {
+            batch.push_back(std::move(job));
+        }
+        begin = end + 1;
+    }
+    connection.in.erase(0, begin);
+    if (connection.in.size() > kMaxLineLength) {
+        return false;
+    }
+
+    if (!batch.empty()) {
+        connection.pending += batch.size();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Job& job : batch) {
+                jobs_.push_back(std::move(job));
+            }
+        }
+        has_jobs_.notify_all();
+    }
+    if (connection.read_closed) {
+        Watch(id, connection);
+    }
+    return true;
+}
+
+bool Server::FlushTo(uint64_t id, Connection& connection) {
+    while (!connection.out.empty()) {
+        ssize_t count = send(connection.fd, connection.out.data(),
+                             connection.out.size(), MSG_NOSIGNAL);
+        if (count > 0) {
+            connection.out.erase(0, count);
+        } else if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    bool want_write = !connection.out.empty();
+    if (want_write != connection.want_write) {
+        connection.want_write = want_write;
+        Watch(id, connection);
+    }
+    return true;
+}
+
+void Server::DeliverResults() {
+    std::vector<Job> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        done.swap(results_);
+    }
+    std::set<uint64_t> touched;
+    for (Job& job : done) {
+        std::map<uint64_t, Connection>::iterator it =
+            connections_.find(job.connection);
+        if (it == connections_.end()) { continue; }  // Client already left.
+        it->second.out += job.line;
+        it->second.pending--;
+        touched.insert(job.connection);
+    }
+    for (uint64_t id : touched) {
+        Connection& connection = connections_[id];
+        if (!FlushTo(id, connection) ||
+            (connection.read_closed && connection.pending == 0 &&
+             connection.out.empty())) {
+            Drop(id);
+        }
+    }
+}
+
+void Server::Watch(uint64_t id, const Connection& connection) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = (connection.read_closed ? 0 : EPOLLIN) |
+        (connection.want_write ? EPOLLOUT : 0);
+    event.data.u64 = id;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection.fd, &event);
+}
+
+void Server::Drop(uint64_t id) {
+    std::map<uint64_t, Connection>::iterator it = connections_.find(id);
+    if (it == connections_.end()) { return; }
+    it->second.cancel->store(true);  // Its queued requests are not needed.
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->second.fd, nullptr);
+    close(it->second.fd);
+    connections_.erase(it);
+}
@@ -0,0 +1,139 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+
+#include "solver.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// @brief Server keeps a Solver loaded and answers solve requests sent over
+/// a Unix domain socket, so clients skip the process startup and prompts
+/// of the interactive program. One thread runs an epoll event loop that
+/// owns every socket; a pool of worker threads runs the searches.
+///
+/// The protocol is line based and may be pipelined: a client can send many
+/// requests without waiting, and responses come back as soon as each search
+/// finishes, possibly out of order. Every line carries the client's id.
+///
+///     request:  <id> <algorithm> <time limit ms> <board>
+///     response: <id> OK <length> <moves> <nodes expanded>
+///               <id> UNSOLVABLE
+///               <id> EXHAUSTED <nodes expanded>
+///               <id> TIMEOUT <nodes expanded>
+///               <id> CANCELLED <nodes expanded>
+///               <id> ERROR <reason>
+///
+/// <algorithm> is any name accepted by Solver::Solve(). <board> uses the
+/// format of board::Parse(), for example "867254301". A time limit of 0
+/// means no limit. It counts from when the request was read, so a request
+/// that waited in the queue past its limit gets "TIMEOUT 0" without being
+/// searched. <moves> holds one letter per move (U, D, L, R), or "-" when the
+/// start is already the goal.
+///
+/// Searches are cancelled when their client disconnects and when the
+/// server shuts down, so workers never stay busy with answers nobody will
+/// read. Such a search answers CANCELLED. The answer is listed for
+/// completeness: its client is gone, or the server stops before it
+/// delivers the answer, so clients should treat it like a lost connection. Every search is memory profiled, and the peaks of the one that
+/// used the most memory are printed when the server stops. With memory
+/// logging on, the peaks of every search are also printed as it finishes,
+/// after its request line.
+///
+/// With learning on, every worker searches with and adds to one shared
+/// LearnedHeuristic, so requests for boards close to earlier ones expand
+/// fewer nodes. Solutions stay optimal, but the nodes expanded reported for
+/// a board then depend on what was solved before it.
+class Server {
+ public:
+    /// @brief Constructs a Server that has not started listening yet.
+    /// @param socket_path File system path of the Unix domain socket.
+    /// @param num_workers Number of threads running searches.
+    /// @param learn Whether searches share a LearnedHeuristic.
+    /// @param log_memory Whether the peak memory of every search is printed.
+    Server(const std::string& socket_path, int num_workers,
+           bool learn = false, bool log_memory = false);
+
+    /// @brief Binds the socket and serves requests until SIGINT or SIGTERM.
+    /// @return 0 on a clean shutdown, -1 if the socket could not be set up.
+    int Run();
+
+ private:
+    /// @brief A request line waiting for, or handled by, a worker.
+    struct Job {
+        uint64_t connection;
+        std::string line;
+        std::chrono::steady_clock::time_point received;
+        std::shared_ptr<std::atomic<bool>> cancel;  // Shared with the client.
+    };
+
+    /// @brief Per-client buffers, only touched by the event loop thread.
+    struct Connection {
+        int fd;
+        std::string in;    // Bytes received but not yet split into lines.
+        std::string out;   // Responses not yet accepted by the socket.
+        int pending;       // Requests queued or being solved.
+        bool want_write;   // Whether EPOLLOUT is currently requested.
+        bool read_closed;  // The client shut down its sending side.
+        std::shared_ptr<std::atomic<bool>> cancel;  // Set when it goes away.
+    };
+
+    /// @brief Body of each worker thread: takes Jobs and solves them.
+    void WorkerLoop();
+
+    /// @brief Parses a request line and runs the search it asks for.
+    /// @param job A single request, without the trailing newline.
+    /// @param profile Receives the memory used by the search, if one ran.
+    /// @return The response line, including the trailing newline.
+    std::string Handle(const Job& job, MemoryProfile* profile) const;
+
+    /// @brief Reads everything available on a client socket and queues
+    /// each complete line as a Job.
+    /// @return false if the client disconnected.
+    bool ReadFrom(uint64_t id, Connection& connection);
+
+    /// @brief Writes as much pending output as the socket accepts and
+    /// toggles EPOLLOUT depending on what is left.
+    /// @return false if the client disconnected.
+    bool FlushTo(uint64_t id, Connection& connection);
+
+    /// @brief Moves finished responses to their Connection's output.
+    void DeliverResults();
+
+    /// @brief Updates the epoll interest of a client to match its state.
+    void Watch(uint64_t id, const Connection& connection);
+
+    /// @brief Closes a client socket and forgets its buffers.
+    void Drop(uint64_t id);
+
+    std::string socket_path_;
+    int num_workers_;
+    int epoll_fd_;
+    int listen_fd_;
+    int wake_fd_;    // eventfd the workers signal when results are ready.
+    int signal_fd_;  // signalfd for SIGINT and SIGTERM.
+    Solver solver_;
+    std::unique_ptr<LearnedHeuristic> learned_;  // Null unless learning.
+    bool log_memory_;
+
+    uint64_t next_id_;
+    std::map<uint64_t, Connection> connections_;
+
+    std::mutex mutex_;  // Guards everything below.
+    std::condition_variable has_jobs_;
+    std::deque<Job> jobs_;
+    std::vector<Job> results_;  // Job::line holds the response here.
+    bool stopping_;
+    MemoryProfile largest_profile_;  // Highest total peak so far.
+    std::string largest_request_;    // Request line of largest_profile_.
+};
+
+#endif // SERVER_HPP
@@ -0,0 +1,119 @@
+#include "solution.hpp"
+
+MoveTable::MoveTable(MemoryAccount* account)
+    : bits_((board::kNumKeys + 3) / 4, 0) {
+    if (account != nullptr) {
+        account->Allocate(kMemoryMoveTable, bits_.capacity());
+    }
+}
+
+void MoveTable::Record(uint32_t key, board::Move move) {
+    int shift = (key % 4) * 2;
+    uint8_t& byte = bits_[key / 4];
+    byte = (byte & ~(3 << shift)) | (move << shift);
+}
+
+board::Move MoveTable::Lookup(uint32_t key) const {
+    int shift = (key % 4) * 2;
+    return static_cast<board::Move>((bits_[key / 4] >> shift) & 3);
+}
+
+Solution::Solution()
+    : status_(kExhausted), length_(0), heuristic_(-1), nodes_expanded_(0),
+      max_frontier_size_(0), final_layer_expanded_(0), nodes_reopened_(0),
+      nodes_stored_(0) {}
+
+Solution::Solution(const std::vector<std::vector<int>>& start,
+                   const std::vector<board::Move>& moves)
+    : start_(start), moves_((moves.size() + 3) / 4, 0), status_(kFound),
+      length_(moves.size()), heuristic_(-1), nodes_expanded_(0),
+      max_frontier_size_(0), final_layer_expanded_(0), nodes_reopened_(0),
+      nodes_stored_(0) {
+    for (int i = 0; i < length_; i++) {
+        moves_[i / 4] |= moves[i] << ((i % 4) * 2);
+    }
+}
+
+bool Solution::Found() const {
+    return status_ == kFound;
+}
+
+Solution::Status Solution::GetStatus() const {
+    return status_;
+}
+
+int Solution::Length() const {
+    return length_;
+}
+
+board::Move Solution::MoveAt(int i) const {
+    return static_cast<board::Move>((moves_[i / 4] >> ((i % 4) * 2)) & 3);
+}
+
+std::string Solution::MoveString() const {
+    std::string str;
+    str.reserve(length_);
+    for (int i = 0; i < length_; i++) {
+        str.push_back(board::MoveLetter(MoveAt(i)));
+    }
+    return str;
+}
+
+std::vector<std::vector<int>> Solution::GetStart() const {
+    return start_;
+}
+
+std::vector<std::vector<int>> Solution::StateAt(const Problem& puzzle,
+                                                int step) const {
+    std::vector<std::vector<int>> state = start_;
+    for (int i = 0; i < step && i < length_; i++) {
+        state = puzzle.ToState(state, board::MoveName(MoveAt(i)));
+    }
+    return state;
+}
+
+int Solution::GetHeuristic() const {
+    return heuristic_;
+}
+
+int Solution::GetNodesExpanded() const {
+    return nodes_expanded_;
+}
+
+int Solution::GetMaxFrontierSize() const {
+    return max_frontier_size_;
+}
+
+int Solution::GetFinalLayerExpanded() const {
+    return final_layer_expanded_;
+}
+
+int Solution::GetNodesReopened() const {
+    return nodes_reopened_;
+}
+
+int Solution::GetNodesStored() const {
+    return nodes_stored_;
+}
+
+void Solution::SetStatus(Status status) {
+    status_ = status;
+}
+
+void Solution::SetHeuristic(int heuristic) {
+    heuristic_ = heuristic;
+}
+
+void Solution::SetStats(int nodes_expanded, int max_frontier_size) {
+    nodes_expanded_ = nodes_expanded;
+    max_frontier_size_ = max_frontier_size;
+}
+
+void Solution::SetPolicyStats(int final_layer_expanded, int nodes_reopened) {
+    final_layer_expanded_ = final_layer_expanded;
+    nodes_reopened_ = nodes_reopened;
+}
+
+void Solution::SetNodesStored(int nodes_stored) {
+    nodes_stored_ = nodes_stored;
+}
@@ -0,0 +1,142 @@
+#ifndef SOLUTION_HPP
+#define SOLUTION_HPP
+
+#include "board.hpp"
+#include "memory_stats.hpp"
+#include "problem.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief MoveTable remembers, for every closed state, the two-bit move that
+/// reached it. It is indexed by board::ToKey() so it costs a fixed quarter
+/// byte per possible state and no memory per Node. Walking the table
+/// backward from the goal recovers the solution path.
+class MoveTable {
+ public:
+    /// @brief Constructs a table with room for every 3x3 state.
+    /// @param account If not null, receives the table's bytes.
+    explicit MoveTable(MemoryAccount* account = nullptr);
+
+    /// @brief Stores the move that led to the state identified by 'key'.
+    /// @param key Value returned by board::ToKey().
+    /// @param move Move taken from the parent state.
+    void Record(uint32_t key, board::Move move);
+
+    /// @brief Reads back a move stored with Record().
+    /// @param key Value returned by board::ToKey().
+    /// @return The recorded move. Undefined if nothing was recorded.
+    board::Move Lookup(uint32_t key) const;
+
+ private:
+    std::vector<uint8_t> bits_;  // Four moves per byte. Never resized.
+};
+
+/// @brief Solution is what every search in Solver returns. It keeps only the
+/// starting state and the moves that solve it, packed two bits each, along
+/// with a few search statistics. Intermediate boards are rebuilt on demand
+/// by replaying the moves from the start.
+class Solution {
+ public:
+    /// @brief How a search ended.
+    enum Status {
+        kFound,      // The goal was reached.
+        kExhausted,  // The frontier ran empty without reaching the goal.
+        kTimedOut,   // SearchOptions::time_limit_ms or deadline came first.
+        kCancelled   // SearchOptions::cancel was set.
+    };
+
+    /// @brief Constructs an empty Solution that represents a failed search.
+    Solution();
+
+    /// @brief Constructs a Solution from a starting state and its moves.
+    /// @param start State the moves are applied to.
+    /// @param moves Moves from 'start' to the goal, in order.
+    Solution(const std::vector<std::vector<int>>& start,
+             const std::vector<board::Move>& moves);
+
+    /// @brief Checks whether the search reached the goal.
+    /// @return true if this Solution holds a path to the goal.
+    bool Found() const;
+
+    /// @brief Accesses how the search ended.
+    Status GetStatus() const;
+
+    /// @brief Accesses the number of moves in the solution path.
+    int Length() const;
+
+    /// @brief Accesses a single move of the solution path.
+    /// @param i Index of the move, 0 being the first move from the start.
+    board::Move MoveAt(int i) const;
+
+    /// @brief Builds a compact, human-readable copy of the path.
+    /// @return One letter per move, for example "ULDR".
+    std::string MoveString() const;
+
+    /// @brief Accesses the state the path begins at.
+    std::vector<std::vector<int>> GetStart() const;
+
+    /// @brief Materializes the board after 'step' moves.
+    /// @param puzzle Problem used to apply the moves.
+    /// @param step Number of moves to replay, between 0 and Length().
+    /// @return 2D vector of the state reached.
+    std::vector<std::vector<int>> StateAt(const Problem& puzzle,
+                                          int step) const;
+
+    /// @brief Accesses the heuristic option the search used.
+    /// @return -1 for Uniform Cost Search, otherwise the option given to
+    /// Solver::AStarSearch.
+    int GetHeuristic() const;
+
+    /// @brief Accesses the number of Nodes the search expanded.
+    int GetNodesExpanded() const;
+
+    /// @brief Accesses the largest size the frontier reached.
+    int GetMaxFrontierSize() const;
+
+    /// @brief Accesses the number of Nodes expanded with the same total
+    /// cost as the goal, i.e. in the last f-layer.
+    int GetFinalLayerExpanded() const;
+
+    /// @brief Accesses the number of times an expanded Node was put back on
+    /// the frontier because a cheaper path to it was found.
+    int GetNodesReopened() const;
+
+    /// @brief Accesses the number of distinct states the search stored.
+    int GetNodesStored() const;
+
+    /// @brief Records how a failed search ended.
+    void SetStatus(Status status);
+
+    /// @brief Records which heuristic produced this Solution.
+    void SetHeuristic(int heuristic);
+
+    /// @brief Records the search statistics.
+    /// @param nodes_expanded Number of Nodes the search expanded.
+    /// @param max_frontier_size Largest size the frontier reached.
+    void SetStats(int nodes_expanded, int max_frontier_size);
+
+    /// @brief Records the statistics that compare search policies.
+    /// @param final_layer_expanded Nodes expanded in the last f-layer.
+    /// @param nodes_reopened Expanded Nodes that were put back on the
+    /// frontier.
+    void SetPolicyStats(int final_layer_expanded, int nodes_reopened);
+
+    /// @brief Records how many distinct states the search stored.
+    void SetNodesStored(int nodes_stored);
+
+ private:
+    std::vector<std::vector<int>> start_;
+    std::vector<uint8_t> moves_;  // Four moves per byte.
+    Status status_;
+    int length_;
+    int heuristic_;
+    int nodes_expanded_;
+    int max_frontier_size_;
+    int final_layer_expanded_;
+    int nodes_reopened_;
+    int nodes_stored_;
+};
+
+#endif // SOLUTION_HPP
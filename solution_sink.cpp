@@ -0,0 +1,112 @@
+#include "solution_sink.hpp"
+
+#include "board.hpp"
+#include "node.hpp"
+
+#include <cctype>
+
+namespace {
+
+// Word used for how a search ended.
+const char* StatusName(Solution::Status status) {
+    switch (status) {
+        case Solution::kFound: return "found";
+        case Solution::kExhausted: return "exhausted";
+        case Solution::kTimedOut: return "timeout";
+        default: return "cancelled";
+    }
+}
+
+// Board text of a packed state, as written by board::Format().
+void AppendBoard(uint64_t state, std::string* text) {
+    for (int cell = 0; cell < board::kCells; cell++) {
+        text->push_back('0' + board::PackedTile(state, cell));
+    }
+}
+
+}  // namespace
+
+SolutionSink::SolutionSink(batch_io::BufferedWriter* out) : out_(out) {}
+
+SolutionSink::~SolutionSink() {}
+
+CompactSink::CompactSink(batch_io::BufferedWriter* out) : SolutionSink(out) {}
+
+void CompactSink::Write(const Problem& puzzle, const Solution& solution) {
+    std::string line;
+    if (solution.Found()) {
+        line = std::to_string(solution.Length()) + " " +
+            (solution.Length() ? solution.MoveString() : "-");
+    } else {
+        line = StatusName(solution.GetStatus());
+        for (char& c : line) {
+            c = std::toupper(c);
+        }
+    }
+    line += " " + std::to_string(solution.GetNodesExpanded()) + "\n";
+    out_->Write(line);
+}
+
+VerboseSink::VerboseSink(batch_io::BufferedWriter* out, const Solver& solver)
+    : SolutionSink(out), solver_(solver) {}
+
+void VerboseSink::Write(const Problem& puzzle, const Solution& solution) {
+    if (!solution.Found()) {
+        return;
+    }
+    Node node(puzzle);
+    for (int step = 0; ; step++) {
+        node.ApplyHeuristic(solver_.Evaluate(node.GetState(),
+                                             solution.GetHeuristic()));
+        node_text_.str("");
+        node_text_ << node << '\n';
+        out_->Write(node_text_.str());
+        if (step == solution.Length()) {
+            break;
+        }
+        node = Node(puzzle, node, board::MoveName(solution.MoveAt(step)));
+    }
+}
+
+JsonSink::JsonSink(batch_io::BufferedWriter* out) : SolutionSink(out) {}
+
+void JsonSink::Write(const Problem& puzzle, const Solution& solution) {
+    uint64_t state = board::Pack(puzzle.GetStartPuzzle());
+    std::string text = "{\"start\":\"";
+    AppendBoard(state, &text);
+    text += "\",\"status\":\"";
+    text += StatusName(solution.GetStatus());
+    text += "\",\"length\":" + std::to_string(solution.Length());
+    text += ",\"moves\":\"" + solution.MoveString();
+    text += "\",\"nodes_expanded\":" +
+        std::to_string(solution.GetNodesExpanded());
+    text += ",\"max_frontier_size\":" +
+        std::to_string(solution.GetMaxFrontierSize());
+    text += ",\"path\":[";
+    if (solution.Found()) {
+        text += "\"";
+        AppendBoard(state, &text);
+        text += "\"";
+        for (int step = 0; step < solution.Length(); step++) {
+            board::ApplyMove(state, solution.MoveAt(step), &state);
+            text += ",\"";
+            AppendBoard(state, &text);
+            text += "\"";
+        }
+    }
+    text += "]}\n";
+    out_->Write(text);
+}
+
+std::unique_ptr<SolutionSink> MakeSolutionSink(const std::string& format,
+                                               batch_io::BufferedWriter* out,
+                                               const Solver& solver) {
+    if (format == "compact") {
+        return std::unique_ptr<SolutionSink>(new CompactSink(out));
+    } else if (format == "verbose") {
+        return std::unique_ptr<SolutionSink>(new VerboseSink(out, solver));
+    } else if (format == "json") {
+        return std::unique_ptr<SolutionSink>(new JsonSink(out));
+    }
+    return std::unique_ptr<SolutionSink>();
+}
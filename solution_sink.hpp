@@ -0,0 +1,78 @@
+#ifndef SOLUTION_SINK_HPP
+#define SOLUTION_SINK_HPP
+
+#include "batch_io.hpp"
+#include "problem.hpp"
+#include "solution.hpp"
+#include "solver.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+/// @brief A SolutionSink renders solved puzzles to a BufferedWriter. Boards
+/// along the path are rebuilt one move at a time from the start state while
+/// they are written, so only the current one is ever held in memory and
+/// nothing is flushed until the writer is.
+class SolutionSink {
+ public:
+    /// @param out Writer that receives the output. Must outlive the sink.
+    explicit SolutionSink(batch_io::BufferedWriter* out);
+    virtual ~SolutionSink();
+
+    /// @brief Renders one Solution.
+    /// @param puzzle The Puzzle instance the Solution was found for.
+    /// @param solution Solution returned by one of the searches.
+    virtual void Write(const Problem& puzzle, const Solution& solution) = 0;
+
+ protected:
+    batch_io::BufferedWriter* out_;
+};
+
+/// @brief One line per Solution: "<length> <moves> <nodes expanded>", with
+/// "-" for an empty move list, or "<STATUS> <nodes expanded>" when the goal
+/// was not reached. STATUS is EXHAUSTED, TIMEOUT or CANCELLED.
+class CompactSink : public SolutionSink {
+ public:
+    explicit CompactSink(batch_io::BufferedWriter* out);
+    void Write(const Problem& puzzle, const Solution& solution) override;
+};
+
+/// @brief Every Node along the path in the format of Node's operator<<,
+/// the way the interactive program prints a solution.
+class VerboseSink : public SolutionSink {
+ public:
+    /// @param solver Used to show the heuristic of each Node. Must outlive
+    /// the sink.
+    VerboseSink(batch_io::BufferedWriter* out, const Solver& solver);
+    void Write(const Problem& puzzle, const Solution& solution) override;
+
+ private:
+    const Solver& solver_;
+    std::ostringstream node_text_;  // Reused for every Node.
+};
+
+/// @brief One JSON object per line, for example
+///
+///     {"start":"120453786","status":"found","length":2,"moves":"DD",
+///      "nodes_expanded":2,"max_frontier_size":3,
+///      "path":["120453786","123450786","123456780"]}
+///
+/// "status" is "found", "exhausted", "timeout" or "cancelled"; "path" lists
+/// every board from the start to the goal in the format of board::Format().
+class JsonSink : public SolutionSink {
+ public:
+    explicit JsonSink(batch_io::BufferedWriter* out);
+    void Write(const Problem& puzzle, const Solution& solution) override;
+};
+
+/// @brief Creates the sink for a format name.
+/// @param format "compact", "verbose" or "json".
+/// @param out Writer that receives the output.
+/// @param solver Solver that found the Solutions.
+/// @return nullptr if 'format' is not one of the names above.
+std::unique_ptr<SolutionSink> MakeSolutionSink(const std::string& format,
+                                               batch_io::BufferedWriter* out,
+                                               const Solver& solver);
+
+#endif // SOLUTION_SINK_HPP
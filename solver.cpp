@@ -1,14 +1,126 @@
 #include "solver.hpp"
+#include "search_space.hpp"
+#include "tables.hpp"
+
+namespace {
+
+// How many loop iterations pass between checks of the clock and of the
+// cancel flag. A few microseconds of searching at most.
+const int kTimeCheckInterval = 256;
+
+// Builds the OpenEntry::tie key of a node. 'sequence' counts the entries
+// pushed so far, so a lower key for a higher sequence means LIFO.
+uint32_t TieKey(SearchOptions::TieBreak tie_break, int path_cost,
+                uint32_t sequence) {
+    switch (tie_break) {
+        case SearchOptions::kTieHigherG:
+            // Path costs fit in 8 bits, leaving 24 bits for LIFO order.
+            return (0xFFu - path_cost) << 24 |
+                   (0xFFFFFFu - (sequence & 0xFFFFFFu));
+        case SearchOptions::kTieLifo:
+            return 0xFFFFFFFFu - sequence;
+        default:
+            return 0;
+    }
+}
+
+// Replaces a state by its board::Reflect() image when that is the smaller
+// packed value, so that a state and its reflection share one node.
+// @return true if 'state' was replaced.
+bool Canonicalize(uint64_t* state) {
+    uint64_t reflected = board::Reflect(*state);
+    if (reflected >= *state) {
+        return false;
+    }
+    *state = reflected;
+    return true;
+}
+
+// Bytes of the generated tables read by the heuristic selected by 'option'.
+size_t HeuristicTableBytes(int option) {
+    switch (option) {
+        case 0: return sizeof(tables::kMisplaced);
+        case 1: return sizeof(tables::kEuclidian);
+        case 2: return sizeof(tables::kManhattan);
+        case 3: return sizeof(tables::kPatternLow) +
+                       sizeof(tables::kPatternHigh);
+        default: return 0;
+    }
+}
 
-/// @brief Functor that is used to sort std::shared_ptr.
-/// Compares the underlying object instead of the pointer address.
-struct SharedPtrCompare {
-    bool operator()(const std::shared_ptr<Node>& lhs,
-                    const std::shared_ptr<Node>& rhs) {
-        return (*lhs) > (*rhs);
+// Appends the live bytes of 'account' to the time series of 'profile' and
+// copies its peaks so far.
+void RecordMemory(const MemoryAccount& account, int nodes_expanded,
+                  std::chrono::steady_clock::time_point started,
+                  MemoryProfile* profile) {
+    MemorySample sample;
+    sample.nodes_expanded = nodes_expanded;
+    sample.elapsed_seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started).count();
+    for (int i = 0; i < kMemoryCategories; i++) {
+        MemoryCategory category = static_cast<MemoryCategory>(i);
+        sample.live[i] = account.Live(category);
+        profile->peak[i] = account.Peak(category);
     }
+    profile->total_peak = account.TotalPeak();
+    profile->samples.push_back(sample);
+}
+
+// Lookups a search made in its LearnedHeuristic, reported when it ends.
+struct LearnedCounts {
+    LearnedCounts() : lookups(0), known(0), tightened(0) {}
+
+    long long lookups;
+    long long known;
+    long long tightened;
 };
 
+// Raises 'heuristic' to the bound 'learned' holds for 'key', if that is
+// higher.
+float Tighten(const LearnedHeuristic& learned, uint32_t key, float heuristic,
+              LearnedCounts* counts) {
+    int bound = learned.Lookup(key);
+    counts->lookups++;
+    if (bound == 0) {
+        return heuristic;
+    }
+    counts->known++;
+    if (bound <= heuristic) {
+        return heuristic;
+    }
+    counts->tightened++;
+    return bound;
+}
+
+// Adds what a search that found an optimal solution proved to 'learned'.
+void Learn(uint64_t start, const Solution& solution, const SearchSpace& space,
+           LearnedHeuristic* learned) {
+    learned->LearnPath(start, solution);
+    if (!learned->LearnClosed()) {
+        return;
+    }
+    for (uint32_t i = 0; i < space.Size(); i++) {
+        if (space.IsClosed(i)) {
+            learned->LearnBound(space.State(i),
+                                solution.Length() - space.PathCost(i));
+        }
+    }
+}
+
+}  // namespace
+
+SearchProgress::SearchProgress()
+    : nodes_expanded(0), open_size(0), f_bound(0), elapsed_seconds(0),
+      nodes_per_second(0) {}
+
+SearchOptions::SearchOptions()
+    : time_limit_ms(0),
+      deadline(std::chrono::steady_clock::time_point::max()),
+      cancel(nullptr), progress_interval_ms(1000), tie_break(kTieHigherG),
+      reopen(kReopenClosed), symmetry(true), reflected_lookup(true),
+      memory_profile(nullptr), memory_sample_interval(1024),
+      learned_heuristic(nullptr) {}
+
 bool Solver::IsSolvable(const Problem& puzzle) const {
     std::vector<std::vector<int>> state = puzzle.GetStartPuzzle();
     std::vector<int> flattened;
@@ -30,331 +142,370 @@ bool Solver::IsSolvable(const Problem& puzzle) const {
     return (inversion_count % 2 == 0);
 }
 
-std::shared_ptr<Node> Solver::UniformCostSearch(const Problem& puzzle) const {
-    SharedPtrCompare desc_order;
-    std::vector<std::shared_ptr<Node>> frontier;
-    std::unordered_set<std::string> explored;
-    int max_frontier_size = 0;
-    int num_nodes_expanded = 0;
-    std::shared_ptr<Node> node = std::make_shared<Node>(puzzle);
-
-    frontier.push_back(std::move(node));
-    while (!frontier.empty()) {
-        if (frontier.size() > max_frontier_size) {
-            max_frontier_size = frontier.size();
-        }
-
-        std::sort(frontier.begin(), frontier.end(), desc_order);
-
-        node = frontier.back();  // Lowest-cost node
-        frontier.pop_back();  // Removes the reference
-
-        if (puzzle.IsGoal(node->GetState())) {
-            std::cout << "To solve this problem the search algorithm " <<
-                "expanded a total of " << num_nodes_expanded <<
-                " node(s)." << std::endl;
-            std::cout << "The maximum number of nodes in the queue " <<
-                "at any one time: " << max_frontier_size << std::endl;
-            return node;
-        }
-        explored.insert(node->ToString());
-
-        // Expand the node by generating children
-        std::vector<std::string> actions = puzzle.GetActions();
-        for (const std::string& action : actions) {
-            std::shared_ptr<Node> child = std::make_shared<Node>(puzzle, node,
-                                                                 action);
-            std::pair<bool, int> in_frontier = StateFound(child.get(),
-                                                          frontier);
-            int in_explored = explored.count(child->ToString());
-            if (!in_frontier.first && !in_explored) {
-                frontier.push_back(std::move(child));
-            } else if (in_frontier.first) {
-                int i = in_frontier.second;
-                if (frontier.at(i)->GetTotalCost() > child->GetTotalCost()) {
-                    frontier.at(i) = child;
-                }
-            }
-        }
-        num_nodes_expanded++;
+bool Solver::Solve(const Problem& puzzle, const std::string& algorithm,
+                   const SearchOptions& options, Solution* solution) const {
+    if (algorithm == "ucs") {
+        *solution = UniformCostSearch(puzzle, options);
+    } else if (algorithm == "misplaced") {
+        *solution = AStarSearch(puzzle, 0, options);
+    } else if (algorithm == "euclidian") {
+        *solution = AStarSearch(puzzle, 1, options);
+    } else if (algorithm == "manhattan") {
+        *solution = AStarSearch(puzzle, 2, options);
+    } else if (algorithm == "pdb") {
+        *solution = AStarSearch(puzzle, 3, options);
+    } else {
+        return false;
     }
-    // Failed if we reach here
-    return nullptr;
+    return true;
 }
 
-std::shared_ptr<Node> Solver::UniformCostSearchTrace(
-        const Problem& puzzle) const {
-    SharedPtrCompare desc_order;
-    std::vector<std::shared_ptr<Node>> frontier;
-    std::unordered_set<std::string> explored;
-    bool first_run = true;
-    int max_frontier_size = 0;
-    int num_nodes_expanded = 0;
-    std::shared_ptr<Node> node = std::make_shared<Node>(puzzle);
-
-    std::cout << "\nExpanding State" << std::endl;
-    puzzle.PrintPuzzleState(node->GetState());
-
-    frontier.push_back(std::move(node));
-    while (!frontier.empty()) {
-        if (frontier.size() > max_frontier_size) {
-            max_frontier_size = frontier.size();
-        }
+Solution Solver::UniformCostSearch(const Problem& puzzle,
+                                   const SearchOptions& options) const {
+    return Search(puzzle, -1, options, false);
+}
 
-        std::sort(frontier.begin(), frontier.end(), desc_order);
+Solution Solver::UniformCostSearchTrace(const Problem& puzzle) const {
+    SearchOptions options;
+    options.symmetry = false;
+    return Search(puzzle, -1, options, true);
+}
 
-        node = frontier.back();  // Lowest-cost node
-        frontier.pop_back();  // Removes the reference
+Solution Solver::AStarSearch(const Problem& puzzle, int option,
+                             const SearchOptions& options) const {
+    return Search(puzzle, option, options, false);
+}
 
-        if (!first_run){
-            std::cout << "Best state to expand with g(n) = " <<
-                node->GetPathCost() << " and h(n) = " <<
-                node->GetDistanceToGoal() << " is... " << std::endl;
-            puzzle.PrintPuzzleState(node->GetState());
-            std::cout << "Expanding this node..." << std::endl;
-        }
-        if (puzzle.IsGoal(node->GetState())) {
-            std::cout << "\nGoal!!!" << std::endl;
-            std::cout << "To solve this problem the search algorithm " <<
-                "expanded a total of " << num_nodes_expanded <<
-                " node(s)." << std::endl;
-            std::cout << "The maximum number of nodes in the queue " <<
-                "at any one time: " << max_frontier_size << std::endl;
-            return node;
-        }
-        explored.insert(node->ToString());
-
-        // Expand the node by generating children
-        std::vector<std::string> actions = puzzle.GetActions();
-        for (const std::string& action : actions) {
-            std::shared_ptr<Node> child = std::make_shared<Node>(puzzle, node,
-                                                                 action);
-            std::pair<bool, int> in_frontier = StateFound(child.get(),
-                                                          frontier);
-            int in_explored = explored.count(child->ToString());
-            if (!in_frontier.first && !in_explored) {
-                frontier.push_back(std::move(child));
-            } else if (in_frontier.first) {
-                int i = in_frontier.second;
-                if (frontier.at(i)->GetTotalCost() > child->GetTotalCost()) {
-                    frontier.at(i) = child;
-                }
-            }
-        }
-        num_nodes_expanded++;
-        first_run = false;
-    }
-    // Failed if we reach here
-    return nullptr;
+Solution Solver::AStarSearchTrace(const Problem& puzzle, int option) const {
+    SearchOptions options;
+    options.symmetry = false;
+    return Search(puzzle, option, options, true);
 }
 
-std::shared_ptr<Node> Solver::AStarSearch(const Problem& puzzle,
-                                          int option) const {
-    SharedPtrCompare desc_order;
-    std::vector<std::shared_ptr<Node>> frontier;
-    std::unordered_set<std::string> explored;
+Solution Solver::Search(const Problem& puzzle, int option,
+                        const SearchOptions& options, bool trace) const {
+    // Declared first so that it outlives the containers reporting to it.
+    MemoryAccount memory;
+    MemoryProfile* profile = options.memory_profile;
+    MemoryAccount* account = profile != nullptr ? &memory : nullptr;
+    if (profile != nullptr) {
+        *profile = MemoryProfile();
+        memory.Allocate(kMemoryHeuristicTables, HeuristicTableBytes(option));
+    }
+    SearchSpace space(account);
+    OpenList frontier(OpenEntryOrder(), OpenEntries(
+        CountingAllocator<OpenEntry>(account, kMemoryOpenList)));
+    MoveTable moves(account);  // Action that reached each explored state.
+    // Uniform Cost Search ignores heuristics, learned ones included. Learned
+    // bounds make the heuristic inconsistent, so they are only read by a
+    // search that reopens closed nodes.
+    const LearnedHeuristic* lookup =
+        option >= 0 && options.reopen == SearchOptions::kReopenClosed ?
+        options.learned_heuristic : nullptr;
+    LearnedCounts learned_counts;
+    int open_nodes = 0;  // Nodes in 'frontier', not counting stale entries.
     int max_frontier_size = 0;
     int num_nodes_expanded = 0;
-    std::shared_ptr<Node> node = std::make_shared<Node>(puzzle);
-    if (option == 0) {
-        node->ApplyHeuristic(MisplacedTile(node->GetState()));
-    } else {
-        node->ApplyHeuristic(EuclidianDistance(node->GetState()));
+    int num_nodes_reopened = 0;
+    float layer_cost = -1;  // Total cost of the f-layer being expanded.
+    int layer_expanded = 0;
+    uint32_t sequence = 0;  // Entries pushed so far, for TieKey().
+    bool first_run = true;
+    std::chrono::steady_clock::time_point started =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point next_report = started +
+        std::chrono::milliseconds(options.progress_interval_ms);
+
+    uint64_t start = board::Pack(puzzle.GetStartPuzzle());
+    uint64_t goal = board::Pack(puzzle.GetGoalState());  // Its own reflection
+    uint64_t root_state = start;
+    if (options.symmetry) {
+        Canonicalize(&root_state);
+    }
+    uint32_t root_key = board::PackedKey(root_state);
+    float root_heuristic = Heuristic(root_state, option,
+                                     options.reflected_lookup);
+    if (lookup != nullptr) {
+        root_heuristic = Tighten(*lookup, root_key, root_heuristic,
+                                 &learned_counts);
+    }
+    uint32_t root = space.Add(root_state, root_key, 0, root_heuristic,
+                              SearchSpace::kNoMove);
+    OpenEntry entry = { space.TotalCost(root),
+                        TieKey(options.tie_break, 0, sequence++), root };
+    frontier.push(entry);
+    open_nodes++;
+
+    if (trace) {
+        std::cout << "\nExpanding State" << std::endl;
+        puzzle.PrintPuzzleState(puzzle.GetStartPuzzle());
     }
 
-    frontier.push_back(std::move(node));
-    while (!frontier.empty()) {
-        if (frontier.size() > max_frontier_size) {
-            max_frontier_size = frontier.size();
-        }
-
-        std::sort(frontier.begin(), frontier.end(), desc_order);
-
-        node = frontier.back();  // Lowest-cost node
-        frontier.pop_back();  // Removes the reference
-
-        if (puzzle.IsGoal(node->GetState())) {
-            std::cout << "To solve this problem the search algorithm " <<
-                "expanded a total of " << num_nodes_expanded <<
-                " node(s)." << std::endl;
-            std::cout << "The maximum number of nodes in the queue " <<
-                "at any one time: " << max_frontier_size << std::endl;
-            return node;
+    for (int iteration = 0; !frontier.empty(); iteration++) {
+        if (open_nodes > max_frontier_size) {
+            max_frontier_size = open_nodes;
         }
-        explored.insert(node->ToString());
-
-        // Expand the node by generating children
-        std::vector<std::string> actions = puzzle.GetActions();
-        for (const std::string& action : actions) {
-            std::shared_ptr<Node> child = std::make_shared<Node>(puzzle,
-                                                                 node, action);
-            if (option == 0) {
-                child->ApplyHeuristic(MisplacedTile(child->GetState()));
-            } else {
-                child->ApplyHeuristic(EuclidianDistance(child->GetState()));
-            }
-            std::pair<bool, int> in_frontier = StateFound(child.get(),
-                                                          frontier);
-            int in_explored = explored.count(child->ToString());
-
-            if (!in_frontier.first && !in_explored) {
-                frontier.push_back(std::move(child));
-            } else if (in_frontier.first) {
-                int i = in_frontier.second;
-                if (frontier.at(i)->GetTotalCost() > child->GetTotalCost()) {
-                    frontier.at(i) = child;
+        if (iteration % kTimeCheckInterval == 0) {
+            std::chrono::steady_clock::time_point now =
+                std::chrono::steady_clock::now();
+            bool cancelled = options.cancel != nullptr &&
+                options.cancel->load(std::memory_order_relaxed);
+            if (cancelled || OutOfTime(options, started, now)) {
+                Solution stopped;
+                stopped.SetStatus(cancelled ? Solution::kCancelled :
+                                  Solution::kTimedOut);
+                stopped.SetHeuristic(option);
+                stopped.SetStats(num_nodes_expanded, max_frontier_size);
+                stopped.SetNodesStored(space.Size());
+                if (profile != nullptr) {
+                    RecordMemory(memory, num_nodes_expanded, started, profile);
+                }
+                if (lookup != nullptr) {
+                    options.learned_heuristic->CountLookups(
+                        learned_counts.lookups, learned_counts.known,
+                        learned_counts.tightened);
                 }
+                return stopped;
+            }
+            if (options.progress && now >= next_report) {
+                SearchProgress progress;
+                progress.nodes_expanded = num_nodes_expanded;
+                progress.open_size = open_nodes;
+                progress.f_bound = layer_cost;
+                progress.elapsed_seconds =
+                    std::chrono::duration<double>(now - started).count();
+                // A report right at the start has no elapsed time yet.
+                progress.nodes_per_second = progress.elapsed_seconds > 0 ?
+                    num_nodes_expanded / progress.elapsed_seconds : 0;
+                options.progress(progress);
+                next_report = now +
+                    std::chrono::milliseconds(options.progress_interval_ms);
             }
         }
-        num_nodes_expanded++;
-    }
-    // Failed if we reach here
-    return nullptr;
-}
 
-std::shared_ptr<Node> Solver::AStarSearchTrace(const Problem& puzzle,
-                                               int option) const {
-    SharedPtrCompare desc_order;
-    std::vector<std::shared_ptr<Node>> frontier;
-    std::unordered_set<std::string> explored;
-    bool first_run = true;
-    int max_frontier_size = 0;
-    int num_nodes_expanded = 0;
-    std::shared_ptr<Node> node = std::make_shared<Node>(puzzle);
-    if (option == 0) {
-        node->ApplyHeuristic(MisplacedTile(node->GetState()));
-    } else {
-        node->ApplyHeuristic(EuclidianDistance(node->GetState()));
-    }
-
-    std::cout << "\nExpanding State" << std::endl;
-    puzzle.PrintPuzzleState(node->GetState());
-
-    frontier.push_back(std::move(node));
-    while (!frontier.empty()) {
-        if (frontier.size() > max_frontier_size) {
-            max_frontier_size = frontier.size();
+        entry = frontier.top();  // Lowest-cost node
+        frontier.pop();
+        uint32_t node = entry.index;
+        // Skip entries left behind when a cheaper path was found.
+        if (space.IsClosed(node) || entry.total_cost > space.TotalCost(node)) {
+            continue;
+        }
+        space.Close(node);
+        open_nodes--;
+        if (entry.total_cost > layer_cost) {
+            layer_cost = entry.total_cost;
+            layer_expanded = 0;
+        }
+        uint64_t state = space.State(node);
+        if (space.Move(node) != SearchSpace::kNoMove) {
+            moves.Record(space.Key(node),
+                         static_cast<board::Move>(space.Move(node)));
         }
 
-        std::sort(frontier.begin(), frontier.end(), desc_order);
-
-        node = frontier.back();  // Lowest-cost node
-        frontier.pop_back();  // Removes the reference
-
-        if (!first_run){
+        if (trace && !first_run) {
             std::cout << "Best state to expand with g(n) = " <<
-                node->GetPathCost() << " and h(n) = " <<
-                node->GetDistanceToGoal() << " is... " << std::endl;
-            puzzle.PrintPuzzleState(node->GetState());
+                space.PathCost(node) << " and h(n) = " <<
+                space.Heuristic(node) << " is... " << std::endl;
+            puzzle.PrintPuzzleState(board::Unpack(state));
             std::cout << "Expanding this node..." << std::endl;
         }
-        if (puzzle.IsGoal(node->GetState())) {
-            std::cout << "\nGoal!!!" << std::endl;
-            std::cout << "To solve this problem the search algorithm " <<
-                "expanded a total of " << num_nodes_expanded <<
-                " node(s)." << std::endl;
-            std::cout << "The maximum number of nodes in the queue " <<
-                "at any one time: " << max_frontier_size << std::endl;
-            return node;
+        if (state == goal) {
+            if (trace) {
+                std::cout << "\nGoal!!!" << std::endl;
+            }
+            Solution solution = TraceBack(start, state, moves,
+                                          options.symmetry);
+            solution.SetHeuristic(option);
+            solution.SetStats(num_nodes_expanded, max_frontier_size);
+            solution.SetNodesStored(space.Size());
+            solution.SetPolicyStats(layer_expanded, num_nodes_reopened);
+            if (profile != nullptr) {
+                RecordMemory(memory, num_nodes_expanded, started, profile);
+            }
+            if (lookup != nullptr) {
+                options.learned_heuristic->CountLookups(
+                    learned_counts.lookups, learned_counts.known,
+                    learned_counts.tightened);
+            }
+            // With kNeverReopen the solution may not be optimal, and what
+            // it seems to prove may not hold.
+            if (options.learned_heuristic != nullptr &&
+                    options.reopen == SearchOptions::kReopenClosed) {
+                Learn(start, solution, space, options.learned_heuristic);
+            }
+            return solution;
         }
-        explored.insert(node->ToString());
-
-        // Expand the node by generating children
-        std::vector<std::string> actions = puzzle.GetActions();
-        for (const std::string& action : actions) {
-            std::shared_ptr<Node> child = std::make_shared<Node>(puzzle,
-                                                                 node, action);
-            if (option == 0) {
-                child->ApplyHeuristic(MisplacedTile(child->GetState()));
-            } else {
-                child->ApplyHeuristic(EuclidianDistance(child->GetState()));
+
+        // Expand the node by generating children. Every action costs 1,
+        // as in Problem::ActionCost().
+        int path_cost = space.PathCost(node) + 1;
+        for (int action = 0; action < 4; action++) {
+            uint64_t child;
+            if (!board::ApplyMove(state, static_cast<board::Move>(action),
+                                  &child)) {
+                continue;
+            }
+            board::Move move = static_cast<board::Move>(action);
+            // A reflected state is stored with the reflected move, which
+            // reaches it from the reflection of 'state'.
+            if (options.symmetry && Canonicalize(&child)) {
+                move = board::Mirror(move);
             }
-            std::pair<bool, int> in_frontier = StateFound(child.get(),
-                                                          frontier);
-            int in_explored = explored.count(child->ToString());
-            if (!in_frontier.first && !in_explored) {
-                frontier.push_back(std::move(child));
-            } else if (in_frontier.first) {
-                int i = in_frontier.second;
-                if (frontier.at(i)->GetTotalCost() > child->GetTotalCost()) {
-                    frontier.at(i) = child;
+            uint32_t key = board::PackedKey(child);
+            uint32_t found = space.Find(key);
+            if (found == SearchSpace::kNone) {
+                float heuristic = Heuristic(child, option,
+                                            options.reflected_lookup);
+                if (lookup != nullptr) {
+                    heuristic = Tighten(*lookup, key, heuristic,
+                                        &learned_counts);
                 }
+                found = space.Add(child, key, path_cost, heuristic, move);
+                open_nodes++;
+            } else if (space.PathCost(found) > path_cost) {
+                if (space.IsClosed(found)) {
+                    if (options.reopen == SearchOptions::kNeverReopen) {
+                        continue;
+                    }
+                    space.Reopen(found);
+                    open_nodes++;
+                    num_nodes_reopened++;
+                }
+                space.Update(found, path_cost, move);
+            } else {
+                continue;
             }
+            OpenEntry child_entry = {
+                space.TotalCost(found),
+                TieKey(options.tie_break, path_cost, sequence++), found };
+            frontier.push(child_entry);
         }
         num_nodes_expanded++;
+        layer_expanded++;
         first_run = false;
+        if (profile != nullptr && options.memory_sample_interval > 0 &&
+                num_nodes_expanded % options.memory_sample_interval == 0) {
+            RecordMemory(memory, num_nodes_expanded, started, profile);
+        }
     }
     // Failed if we reach here
-    return nullptr;
+    Solution failed;
+    failed.SetHeuristic(option);
+    failed.SetStats(num_nodes_expanded, max_frontier_size);
+    failed.SetPolicyStats(0, num_nodes_reopened);
+    failed.SetNodesStored(space.Size());
+    if (profile != nullptr) {
+        RecordMemory(memory, num_nodes_expanded, started, profile);
+    }
+    if (lookup != nullptr) {
+        options.learned_heuristic->CountLookups(learned_counts.lookups,
+                                                learned_counts.known,
+                                                learned_counts.tightened);
+    }
+    return failed;
 }
 
-std::pair<bool, int> Solver::StateFound(
-        const Node* node,
-        const std::vector<std::shared_ptr<Node>>& frontier) const {
-    std::pair<bool, int> result;
-    for (int i = 0; i < frontier.size(); i++) {
-        if (node->GetState() == frontier.at(i)->GetState()) {
-            result.first = true;
-            result.second = i;
-            return result;
-        }
+bool Solver::OutOfTime(const SearchOptions& options,
+                       std::chrono::steady_clock::time_point start,
+                       std::chrono::steady_clock::time_point now) const {
+    if (now >= options.deadline) {
+        return true;
     }
-    result.first = false;
-    result.second = -1;
-    return result;
+    if (options.time_limit_ms <= 0) {
+        return false;
+    }
+    return now - start >= std::chrono::milliseconds(options.time_limit_ms);
 }
 
-std::pair<int, int> Solver::FindExpectedLocation(int target,
-                                                 int state_size) const {
-    if (target == 0) {
-        return std::make_pair(state_size - 1, state_size - 1);
+double Solver::Evaluate(const std::vector<std::vector<int>>& state,
+                        int option) const {
+    return Heuristic(board::Pack(state), option, true);
+}
+
+Solution Solver::TraceBack(uint64_t start, uint64_t state,
+                           const MoveTable& moves, bool symmetry) const {
+    std::vector<board::Move> path;
+    uint64_t reflected_start = symmetry ? board::Reflect(start) : start;
+    // Every state on the path was explored, so its move is in the table.
+    // With symmetry the table is keyed by the node that holds the state,
+    // which may be its reflection, and the path may lead back to the
+    // reflection of the start instead.
+    while (state != start && state != reflected_start) {
+        uint64_t stored = state;
+        bool reflected = symmetry && Canonicalize(&stored);
+        board::Move move = moves.Lookup(board::PackedKey(stored));
+        if (reflected) {
+            move = board::Mirror(move);  // The move into the reflection.
+        }
+        path.push_back(move);
+        // No path visits more states than there are, so a longer one means
+        // the table is corrupt. Fail instead of looping forever.
+        if (!board::ApplyMove(state, board::Inverse(move), &state) ||
+                path.size() > board::kNumKeys) {
+            return Solution();
+        }
     }
+    if (state != start) {
+        // Found a path from the reflected start, which mirrors into a path
+        // from the start because the goal is its own reflection.
+        for (size_t i = 0; i < path.size(); i++) {
+            path[i] = board::Mirror(path[i]);
+        }
+    }
+    std::reverse(path.begin(), path.end());
+    return Solution(board::Unpack(start), path);
+}
 
-    int row_loc;
-    int column_loc = target % state_size;
-    // When column_loc == 0 that means we have a number on the right edge
-    // of the puzzle (not including 0). Example: 3 is on the top right of an
-    // 8 Puzzle and 3 mod 3 == 0. We subtract 1 to (target / state_size),
-    // because 3 / 3 = 1 which is not the row location for a 3.
-    if (column_loc == 0) {
-        column_loc = state_size - 1;
-        row_loc = (target / state_size) - 1;
-    } else {
-        column_loc -= 1;
-        row_loc = target / state_size;
+double Solver::Heuristic(uint64_t state, int option, bool reflected) const {
+    switch (option) {
+        case -1: return 0;  // Uniform Cost Search
+        case 0: return MisplacedTile(state);
+        case 1: return EuclidianDistance(state);
+        case 2: return ManhattanDistance(state);
+        default:
+            if (!reflected) {
+                return PatternDatabase(state);
+            }
+            // A state and its reflection are equally far from the goal, but
+            // the reflection splits the tiles into different halves, so its
+            // lookup is a second, independent lower bound. The other
+            // heuristics give the same value for both.
+            return std::max(PatternDatabase(state),
+                            PatternDatabase(board::Reflect(state)));
     }
-    return std::make_pair(row_loc, column_loc);
 }
 
-int Solver::MisplacedTile(const std::vector<std::vector<int>>& state) const {
-    int expected = 1;
+int Solver::MisplacedTile(uint64_t state) const {
     int num_misplaced = 0;
-    for (int i = 0; i < state.size(); i++) {
-        for (int j = 0; j < state.at(i).size(); j++) {
-            // We don't account for the blank tile position
-            if (!(i == state.size() - 1 && j == state.at(i).size() - 1)) {
-                if (state.at(i).at(j) != expected++) {
-                    num_misplaced++;
-                }
-            }
-        }
+    for (int cell = 0; cell < board::kCells; cell++) {
+        // The table never counts the blank tile
+        num_misplaced += tables::kMisplaced[board::PackedTile(state, cell)][cell];
     }
     return num_misplaced;
 }
 
-double Solver::EuclidianDistance(
-        const std::vector<std::vector<int>>& state) const {
-    int size = state.size();
-    std::pair<int, int> correct_loc;
+double Solver::EuclidianDistance(uint64_t state) const {
     double total = 0;
-    for (int i = 0; i < size; i++) {
-        for (int j = 0; j < size; j++) {
-            if (state.at(i).at(j) == 0) { continue; }
-            correct_loc = FindExpectedLocation(state.at(i).at(j), size);
-            int row_dist = correct_loc.first - i;
-            int col_dist = correct_loc.second - j;
-            total += std::sqrt(std::pow(row_dist, 2) + std::pow(col_dist, 2));
-        }
+    for (int cell = 0; cell < board::kCells; cell++) {
+        total += tables::kEuclidian[board::PackedTile(state, cell)][cell];
     }
     return total;
-}
\ No newline at end of file
+}
+
+int Solver::ManhattanDistance(uint64_t state) const {
+    int total = 0;
+    for (int cell = 0; cell < board::kCells; cell++) {
+        total += tables::kManhattan[board::PackedTile(state, cell)][cell];
+    }
+    return total;
+}
+
+int Solver::PatternDatabase(uint64_t state) const {
+    int cells[board::kCells];
+    for (int cell = 0; cell < board::kCells; cell++) {
+        cells[board::PackedTile(state, cell)] = cell;
+    }
+    int low = ((cells[1] * 9 + cells[2]) * 9 + cells[3]) * 9 + cells[4];
+    int high = ((cells[5] * 9 + cells[6]) * 9 + cells[7]) * 9 + cells[8];
+    return tables::kPatternLow[low] + tables::kPatternHigh[high];
+}
@@ -1,10 +1,14 @@
 #ifndef SOLVER_HPP
 #define SOLVER_HPP
 
+#include "board.hpp"
+#include "learned_heuristic.hpp"
+#include "memory_stats.hpp"
 #include "node.hpp"
 #include "problem.hpp"
+#include "solution.hpp"
 
-#include <unordered_set>
+#include <cstdint>
 #include <vector>
 #include <iostream>
 #include <string>
@@ -12,6 +16,108 @@
 #include <algorithm>
 #include <utility>
 #include <cmath>
+#include <chrono>
+#include <atomic>
+#include <functional>
+
+/// @brief Snapshot of a running search, handed to SearchOptions::progress.
+struct SearchProgress {
+    SearchProgress();
+
+    int nodes_expanded;
+    int open_size;            // Nodes waiting on the frontier.
+    double f_bound;           // Total cost of the Nodes being expanded.
+    double elapsed_seconds;   // Since the search started.
+    double nodes_per_second;  // nodes_expanded / elapsed_seconds.
+};
+
+/// @brief Optional settings for the searches. The defaults are what the
+/// interactive solver uses.
+struct SearchOptions {
+    /// @brief Which of several Nodes with the same total cost is expanded
+    /// first. Any choice keeps the solution optimal, but picking the Node
+    /// closest to the goal usually reaches it with fewer expansions in the
+    /// last f-layer.
+    enum TieBreak {
+        kTieArbitrary,  // Whatever order the heap yields.
+        kTieHigherG,    // Highest path cost (lowest heuristic), then LIFO.
+        kTieLifo        // Most recently generated.
+    };
+
+    /// @brief What to do when a cheaper path reaches a state that has
+    /// already been expanded. That only happens with an inconsistent
+    /// heuristic. The pattern database is one: each half assumes the blank
+    /// is wherever suits it best, so a single move can lower it by more
+    /// than 1, and without reopening its solutions may not be optimal.
+    enum ReopenPolicy {
+        kNeverReopen,   // Keep the first path found to each state.
+        kReopenClosed   // Put the state back on the open list.
+    };
+
+    SearchOptions();
+
+    /// Wall clock budget in milliseconds. The search gives up and returns a
+    /// Solution with status kTimedOut once it runs out. Zero means no limit.
+    long time_limit_ms;
+
+    /// Point in time at which the search gives up with kTimedOut, for
+    /// budgets that started before the search did, such as time spent
+    /// waiting in a queue. Defaults to time_point::max(), which never comes.
+    std::chrono::steady_clock::time_point deadline;
+
+    /// Flag another thread sets to stop the search, which then returns a
+    /// Solution with status kCancelled. Defaults to nullptr.
+    const std::atomic<bool>* cancel;
+
+    /// Called from the searching thread about every progress_interval_ms.
+    /// Defaults to empty, which reports nothing.
+    std::function<void(const SearchProgress&)> progress;
+
+    /// Defaults to 1000.
+    long progress_interval_ms;
+
+    /// Defaults to kTieHigherG.
+    TieBreak tie_break;
+
+    /// Defaults to kReopenClosed, which costs nothing when the heuristic
+    /// is consistent.
+    ReopenPolicy reopen;
+
+    /// Whether a state and its board::Reflect() image share one node.
+    /// The goal is its own reflection, so both are equally far from it and
+    /// only one needs to be expanded, which roughly halves the states
+    /// stored. The path is mirrored back when it is rebuilt. It matters
+    /// most for weak heuristics: tools/symmetry_bench shows a third fewer
+    /// expansions for Uniform Cost Search, and almost none for "pdb" with
+    /// reflected_lookup. Defaults to true; the trace searches turn it off
+    /// so that every state they print is one the puzzle really passes
+    /// through.
+    bool symmetry;
+
+    /// Whether the pattern database heuristic also looks up the
+    /// board::Reflect() image of each state and keeps the larger of the two
+    /// values. The reflection splits the tiles into different halves, so
+    /// its lookup is a second lower bound. Only "pdb" is affected; the
+    /// other heuristics give the same value for both. Defaults to true.
+    bool reflected_lookup;
+
+    /// If not null, receives the peak bytes of each MemoryCategory and a
+    /// sample of the live bytes every memory_sample_interval expansions,
+    /// plus one when the search ends. Counting costs a few additions per
+    /// allocation. Defaults to nullptr, which counts nothing.
+    MemoryProfile* memory_profile;
+
+    /// Defaults to 1024. Zero or less only takes the final sample.
+    int memory_sample_interval;
+
+    /// If not null, A* uses the larger of its heuristic and the bound held
+    /// here for each state, and a search that finds the goal adds what it
+    /// proved to the table. Learned bounds make the heuristic inconsistent,
+    /// so the table is only read and added to when reopen is kReopenClosed,
+    /// which keeps the solutions optimal, and ignored otherwise. Uniform
+    /// Cost Search learns but does not look up. Defaults to nullptr.
+    LearnedHeuristic* learned_heuristic;
+};
 
 /// @brief Solver is a collection of algorithms that can be used to find a
 /// solution path from a root Node to a Node with the goal state.
@@ -22,72 +128,137 @@ class Solver {
     /// @return false if the puzzle configuration cannot be solved.
     bool IsSolvable(const Problem& puzzle) const;
 
+    /// @brief Runs one of the non-trace searches picked by name.
+    /// @param puzzle Fully initialized Puzzle instance.
+    /// @param algorithm "ucs" for Uniform Cost Search, or "misplaced",
+    /// "euclidian", "manhattan" or "pdb" for A* with that heuristic.
+    /// @param options Limits applied to the search.
+    /// @param solution Receives the result of the search.
+    /// @return false if 'algorithm' is not one of the names above.
+    bool Solve(const Problem& puzzle, const std::string& algorithm,
+               const SearchOptions& options, Solution* solution) const;
+
     /// @brief Applies the Uniform Cost Search algorithm to the search graph.
     /// @param puzzle Fully initialized Puzzle instance.
-    /// @return Shared pointer to a Node that contains the goal state. Nullptr
-    /// if queue is ever empty and a Node with the goal state is not found.
-    std::shared_ptr<Node> UniformCostSearch(const Problem& puzzle) const;
+    /// @return Solution holding the path to the goal state. Solution::Found()
+    /// is false if the queue is ever empty and the goal state is not found.
+    /// @param options Limits applied to the search.
+    Solution UniformCostSearch(
+            const Problem& puzzle,
+            const SearchOptions& options = SearchOptions()) const;
 
     /// @brief Applies the Uniform Cost Search algorithm to the search graph
     /// and prints out a live trace of the Node's that are being expanded.
     /// @param puzzle Fully initialized Puzzle instance.
-    /// @return Shared pointer to a Node that contains the goal state. Nullptr
-    /// if queue is ever empty and a Node with the goal state is not found.
-    std::shared_ptr<Node> UniformCostSearchTrace(const Problem& puzzle) const;
+    /// @return Solution holding the path to the goal state. Solution::Found()
+    /// is false if the queue is ever empty and the goal state is not found.
+    Solution UniformCostSearchTrace(const Problem& puzzle) const;
 
     /// @brief Applies the A* Search algorithm to the search graph. The
     /// heuristic used depends on the value of 'option'.
     /// @param puzzle Fully initialized Puzzle instance.
     /// @param option 0 to use Misplaced Tile as the heuristic. 1 to use
-    /// Euclidian Distance as the heuristic.
-    /// @return Shared pointer to a Node that contains the goal state. Nullptr
-    /// if queue is ever empty and a Node with the goal state is not found.
-    std::shared_ptr<Node> AStarSearch(const Problem& puzzle, int option) const;
+    /// Euclidian Distance, 2 to use Manhattan Distance and 3 to use the
+    /// additive pattern database as the heuristic.
+    /// @return Solution holding the path to the goal state. Solution::Found()
+    /// is false if the queue is ever empty and the goal state is not found.
+    /// @param options Limits applied to the search.
+    Solution AStarSearch(const Problem& puzzle, int option,
+                         const SearchOptions& options = SearchOptions()) const;
 
     /// @brief Applies the A* Search algorithm to the search graph and prints
     /// out a live trace of the Node's that are being expanded. The
     /// heuristic used depends on the value of 'option'.
     /// @param puzzle Fully initialized Puzzle instance.
     /// @param option 0 to use Misplaced Tile as the heuristic. 1 to use
-    /// Euclidian Distance as the heuristic.
-    /// @return Shared pointer to a Node that contains the goal state. Nullptr
-    /// if queue is ever empty and a Node with the goal state is not found.
-    std::shared_ptr<Node> AStarSearchTrace(const Problem& puzzle,
-                                           int option) const;
+    /// Euclidian Distance, 2 to use Manhattan Distance and 3 to use the
+    /// additive pattern database as the heuristic.
+    /// @return Solution holding the path to the goal state. Solution::Found()
+    /// is false if the queue is ever empty and the goal state is not found.
+    Solution AStarSearchTrace(const Problem& puzzle, int option) const;
+
+    /// @brief Evaluates one of the heuristics outside of a search, so that
+    /// Nodes rebuilt from a Solution show the costs the search assigned.
+    /// @param state 3x3 puzzle state.
+    /// @param option Solution::GetHeuristic() of the search.
+    /// @return The estimated cost for 'state' to reach the goal.
+    double Evaluate(const std::vector<std::vector<int>>& state,
+                    int option) const;
 
  private:
-    /// @brief Searches the 'frontier' for the existence of Node's state.
-    /// @param node Raw pointer to a Node. A std::shared_ptr is not needed
-    /// since we only need to access the underlying object.
-    /// @param frontier Vector of std::shared_ptr to search through.
-    /// @return true, and the index if the Node's state is found, false and
-    /// -1 if the state is not found.
-    std::pair<bool, int> StateFound(
-            const Node* node,
-            const std::vector<std::shared_ptr<Node>>& frontier) const;
-
-    /// @brief Calculates the expected position of 'target' in a
-    /// completed puzzle.
-    /// @param target Tile we want the expected position of.
-    /// @param state_size Size N of an (NxN)-1 Puzzle. Example: an 8 Puzzle
-    /// is of size 3... (3x3)-1 = 8.
-    /// @return The row and column where 'target' should be found.
-    std::pair<int, int> FindExpectedLocation(int target, int state_size) const;
+    /// @brief Checks whether a search has used up its time budget.
+    /// @param options Options the search was started with.
+    /// @param start When the search was started.
+    /// @param now The current time.
+    /// @return true if options.deadline has passed, or if
+    /// options.time_limit_ms is set and has elapsed.
+    bool OutOfTime(const SearchOptions& options,
+                   std::chrono::steady_clock::time_point start,
+                   std::chrono::steady_clock::time_point now) const;
+
+    /// @brief Best-first search shared by every public search. Nodes live
+    /// in a SearchSpace, so each one is a few packed fields instead of a heap
+    /// allocated Node, and the open list only holds (f, index) pairs.
+    /// @param puzzle Fully initialized Puzzle instance.
+    /// @param option -1 for Uniform Cost Search, otherwise the same meaning
+    /// as in AStarSearch().
+    /// @param options Limits applied to the search.
+    /// @param trace true to print each Node as it is expanded.
+    /// @return Solution holding the path to the goal state.
+    Solution Search(const Problem& puzzle, int option,
+                    const SearchOptions& options, bool trace) const;
+
+    /// @brief Walks the MoveTable backward from the goal to the start
+    /// state to recover the moves of the solution path.
+    /// @param start Packed start state.
+    /// @param state Packed goal state that was reached.
+    /// @param moves Table filled in while the search explored states.
+    /// @param symmetry Same as SearchOptions::symmetry for the search that
+    /// filled in 'moves'.
+    /// @return Solution holding the path from 'start' to 'state', or one
+    /// that is not Found() if the table leads elsewhere, which is a bug.
+    Solution TraceBack(uint64_t start, uint64_t state,
+                       const MoveTable& moves, bool symmetry) const;
+
+    /// @brief Evaluates the heuristic selected by 'option'.
+    /// @param state Packed state that the heuristic will be applied on.
+    /// @param option Same meaning as in Search().
+    /// @param reflected Same as SearchOptions::reflected_lookup.
+    /// @return The estimated cost for 'state' to reach the goal.
+    double Heuristic(uint64_t state, int option, bool reflected) const;
 
     /// @brief Counts the number of tiles out of place. That value is used
     /// to find a better route to the goal state. This does not account
     /// for the position of the blank tile.
-    /// @param state A Node's state that the heuristic will be applied on.
+    /// @param state Packed state that the heuristic will be applied on.
     /// @return Number of tiles that are not in their expected  position.
-    int MisplacedTile(const std::vector<std::vector<int>>& state) const;
+    int MisplacedTile(uint64_t state) const;
 
     /// @brief Finds the total distance that tiles need to travel to reach
     /// their expected location. That value is used to find a better route
     /// to the goal state. This does not account for the blank tile.
-    /// @param state A Node's state that the heuristic will be applied on.
+    /// @param state Packed state that the heuristic will be applied on.
     /// @return Sum of the Euclidian Distance from each tile to its
     /// expected position.
-    double EuclidianDistance(const std::vector<std::vector<int>>& state) const;
+    double EuclidianDistance(uint64_t state) const;
+
+    /// @brief Adds up how many rows and columns each tile is away from its
+    /// expected location. Like the other heuristics it is read from the
+    /// tables generated at build time and ignores the blank tile.
+    /// @param state Packed state that the heuristic will be applied on.
+    /// @return Sum of the Manhattan Distance from each tile to its
+    /// expected position.
+    int ManhattanDistance(uint64_t state) const;
+
+    /// @brief Looks up the additive pattern databases for tiles 1-4 and
+    /// tiles 5-8 and adds the two. Each database holds the exact number of
+    /// moves of its own tiles needed to place them, so the sum never
+    /// overestimates and dominates Manhattan Distance. Heuristic() may also
+    /// look up the board::Reflect() image of the state and keep the larger
+    /// of the two values.
+    /// @param state Packed state that the heuristic will be applied on.
+    /// @return Lower bound on the number of moves left.
+    int PatternDatabase(uint64_t state) const;
 };
 
 #endif // SOLVER_HPP
\ No newline at end of file
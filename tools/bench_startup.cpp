@@ -0,0 +1,84 @@
+// Startup latency benchmark: measures time-to-first-solve of the puzzle
+// binary, from spawning the process to its exit after one solve, which
+// covers loading, table setup and the search itself.
+//
+// Usage: bench_startup [--program ./puzzle] [--runs N] [--board B]
+//                      [--algorithm NAME]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+typedef std::chrono::steady_clock Clock;
+
+int main(int argc, char* argv[]) {
+    std::string program = "./puzzle";
+    std::string board = "871602543";  // "Oh Boy" from the README.
+    std::string algorithm = "pdb";
+    int runs = 50;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--program") { program = argv[i + 1]; }
+        else if (flag == "--runs") { runs = std::atoi(argv[i + 1]); }
+        else if (flag == "--board") { board = argv[i + 1]; }
+        else if (flag == "--algorithm") { algorithm = argv[i + 1]; }
+        else {
+            std::cerr << "Unknown option " << flag << std::endl;
+            return 1;
+        }
+    }
+    if (runs < 1) { runs = 1; }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null",
+                                     O_WRONLY, 0);
+
+    std::vector<char*> args;
+    args.push_back(const_cast<char*>(program.c_str()));
+    args.push_back(const_cast<char*>("--solve"));
+    args.push_back(const_cast<char*>(board.c_str()));
+    args.push_back(const_cast<char*>(algorithm.c_str()));
+    args.push_back(nullptr);
+
+    std::vector<double> times_ms;
+    for (int i = 0; i < runs; i++) {
+        Clock::time_point began = Clock::now();
+        pid_t pid;
+        if (posix_spawn(&pid, program.c_str(), &actions, nullptr, &args[0],
+                        environ) != 0) {
+            std::cerr << "Could not start " << program << std::endl;
+            return 1;
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::cerr << program << " failed to solve " << board << std::endl;
+            return 1;
+        }
+        times_ms.push_back(std::chrono::duration<double, std::milli>(
+            Clock::now() - began).count());
+    }
+    posix_spawn_file_actions_destroy(&actions);
+
+    std::sort(times_ms.begin(), times_ms.end());
+    double total = 0;
+    for (double t : times_ms) { total += t; }
+    std::cout << "Time to first solve over " << runs << " run(s) of " <<
+        program << " --solve " << board << " " << algorithm << "\n";
+    std::cout << "ms: min " << times_ms.front() << ", p50 " <<
+        times_ms[times_ms.size() / 2] << ", mean " << total / runs <<
+        ", max " << times_ms.back() << "\n";
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Differential correctness check of every search the Solver offers.
+//
+// Checks three properties and prints each failure it finds:
+//  - Solver::IsSolvable() agrees with whether the breadth first search of
+//    DistanceTable reaches the board, for every 16th of the 9! boards, or
+//    for all of them with --full;
+//  - on --count solvable boards drawn with a seeded BoardGenerator, every
+//    search mode finds a solution exactly as long as the DistanceTable
+//    distance. The modes cover each heuristic under every tie-breaking
+//    policy, with symmetry off, with a LearnedHeuristic shared by all
+//    boards, with kNeverReopen for the consistent heuristics, alone and
+//    with the shared LearnedHeuristic, and for the pattern database
+//    without the reflected lookup. The two
+//    slowest, Uniform Cost Search and Misplaced Tile, only run on every
+//    --slow-every'th board unless --full is given;
+//  - every solution replays through Problem::ToState(), one legal move at
+//    a time, from the start to the goal.
+// The defaults take a few seconds, so that `make check` can run after
+// every change; it fails if this exits with 1.
+//
+// Usage: difftest [--count N] [--seed S] [--slow-every K] [--full]
+
+#include "../board.hpp"
+#include "../generator.hpp"
+#include "../learned_heuristic.hpp"
+#include "../problem.hpp"
+#include "../solution.hpp"
+#include "../solver.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+// One way of running a search.
+struct Mode {
+    std::string name;
+    std::string algorithm;
+    SearchOptions options;
+    bool slow;  // Only run on every --slow-every'th board.
+};
+
+// Builds every mode checked on each board.
+std::vector<Mode> MakeModes(LearnedHeuristic* learned) {
+    const char* const kHeuristics[] = {
+        "misplaced", "euclidian", "manhattan", "pdb"
+    };
+    const char* const kTieNames[] = { "arbitrary", "higher-g", "lifo" };
+    std::vector<Mode> modes;
+    for (const char* algorithm : kHeuristics) {
+        for (int tie = 0; tie < 3; tie++) {
+            Mode mode;
+            mode.name = std::string(algorithm) + " tie=" + kTieNames[tie];
+            mode.algorithm = algorithm;
+            mode.options.tie_break =
+                static_cast<SearchOptions::TieBreak>(tie);
+            modes.push_back(mode);
+        }
+        Mode no_symmetry;
+        no_symmetry.name = std::string(algorithm) + " symmetry=off";
+        no_symmetry.algorithm = algorithm;
+        no_symmetry.options.symmetry = false;
+        modes.push_back(no_symmetry);
+
+        Mode learning;
+        learning.name = std::string(algorithm) + " learned";
+        learning.algorithm = algorithm;
+        learning.options.learned_heuristic = learned;
+        modes.push_back(learning);
+
+        if (std::string(algorithm) == "pdb") {
+            Mode no_reflection;
+            no_reflection.name = "pdb reflected-lookup=off";
+            no_reflection.algorithm = algorithm;
+            no_reflection.options.reflected_lookup = false;
+            modes.push_back(no_reflection);
+        }
+
+        // The pattern database is inconsistent, so it needs reopening.
+        if (std::string(algorithm) != "pdb") {
+            Mode never_reopen;
+            never_reopen.name = std::string(algorithm) + " reopen=never";
+            never_reopen.algorithm = algorithm;
+            never_reopen.options.reopen = SearchOptions::kNeverReopen;
+            modes.push_back(never_reopen);
+
+            // Without reopening the learned table must be left alone.
+            Mode learned_no_reopen = never_reopen;
+            learned_no_reopen.name = std::string(algorithm) +
+                " learned reopen=never";
+            learned_no_reopen.options.learned_heuristic = learned;
+            modes.push_back(learned_no_reopen);
+        }
+    }
+    Mode ucs;
+    ucs.name = "ucs";
+    ucs.algorithm = "ucs";
+    modes.push_back(ucs);
+    for (Mode& mode : modes) {
+        mode.slow = mode.algorithm == "misplaced" || mode.algorithm == "ucs";
+    }
+    return modes;
+}
+
+// Replays a solution with Problem::ToState().
+// @return true if every move is legal and the last state is the goal.
+bool Replays(const Problem& puzzle, const Solution& solution) {
+    std::vector<std::vector<int>> state = puzzle.GetStartPuzzle();
+    for (int step = 0; step < solution.Length(); step++) {
+        std::vector<std::vector<int>> next =
+            puzzle.ToState(state, board::MoveName(solution.MoveAt(step)));
+        if (next == state) {
+            return false;  // ToState() leaves the state alone when blocked.
+        }
+        state = next;
+    }
+    return puzzle.IsGoal(state);
+}
+
+// Compares IsSolvable() with reachability for every 'stride'th board.
+// @return Number of boards where they disagree.
+int CheckSolvability(const Solver& solve, const DistanceTable& distances,
+                     uint32_t stride) {
+    int failures = 0;
+    for (uint32_t key = 0; key < board::kNumKeys; key += stride) {
+        Problem puzzle;
+        puzzle.Init(board::FromKey(key));
+        bool reachable =
+            distances.Distance(key) != DistanceTable::kUnreachable;
+        if (solve.IsSolvable(puzzle) != reachable) {
+            std::printf("FAIL IsSolvable(%s) is %d\n",
+                        board::Format(puzzle.GetStartPuzzle()).c_str(),
+                        !reachable);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int count = 40;
+    unsigned long long seed = 1;
+    int slow_every = 10;
+    bool full = false;
+    for (int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        bool has_value = i + 1 < argc;
+        if (flag == "--full") { full = true; }
+        else if (flag == "--count" && has_value) {
+            count = std::atoi(argv[++i]);
+        } else if (flag == "--seed" && has_value) {
+            seed = std::strtoull(argv[++i], 0, 10);
+        } else if (flag == "--slow-every" && has_value) {
+            slow_every = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Usage: difftest [--count N] [--seed S] "
+                         "[--slow-every K] [--full]\n");
+            return 1;
+        }
+    }
+    if (full || slow_every < 1) {
+        slow_every = 1;
+    }
+
+    Solver solve;
+    DistanceTable distances;
+    uint32_t stride = full ? 1 : 16;
+    int failures = CheckSolvability(solve, distances, stride);
+
+    LearnedHeuristic learned;
+    std::vector<Mode> modes = MakeModes(&learned);
+    BoardGenerator generator(seed);
+    uint8_t cells[board::kCells];
+    int searches = 0;
+    for (int n = 0; n < count; n++) {
+        generator.NextUniform(cells);
+        std::vector<std::vector<int>> start = board::FromCells(cells);
+        Problem puzzle;
+        puzzle.Init(start);
+        int shortest = distances.Distance(board::ToKey(cells));
+        for (const Mode& mode : modes) {
+            if (mode.slow && n % slow_every != 0) {
+                continue;
+            }
+            Solution solution;
+            solve.Solve(puzzle, mode.algorithm, mode.options, &solution);
+            searches++;
+            const char* problem = nullptr;
+            if (!solution.Found()) {
+                problem = "no solution";
+            } else if (solution.Length() != shortest) {
+                problem = "not the shortest";
+            } else if (!Replays(puzzle, solution)) {
+                problem = "path does not reach the goal";
+            }
+            if (problem != nullptr) {
+                std::printf("FAIL %s %s: %s (length %d, shortest %d)\n",
+                            board::Format(start).c_str(), mode.name.c_str(),
+                            problem, solution.Length(), shortest);
+                failures++;
+            }
+        }
+    }
+
+    std::printf("%d boards, seed %llu: %d searches in %zu modes, "
+                "%u boards checked for solvability, %d failure(s)\n", count,
+                seed, searches, modes.size(),
+                (board::kNumKeys + stride - 1) / stride, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+// libFuzzer entry point over the board parsers.
+//
+// Feeds each input to board::Parse(), to batch_io::ParseTextBoards() and,
+// line by line, to Problem::ParseCustomInput(), and aborts if any of them
+// accepts something it should not: a parsed board must hold each tile
+// once, format back to the same text and survive the ToKey()/FromKey() and
+// Pack()/Unpack() round trips, every key of a text batch must be valid and
+// read back the same from FormatGrid(), and a parsed row must only hold
+// tile numbers.
+//
+// `make fuzz` builds it with clang++ -fsanitize=fuzzer when clang++ is
+// installed. Built with -DFUZZ_PARSE_MAIN instead, as `make check` does,
+// it runs each file named on the command line, or without arguments a
+// fixed set of random and mutated inputs, through the same checks, and
+// then checks that the binary batch readers reject truncated headers and
+// record counts too large for the file.
+
+#include "../batch_io.hpp"
+#include "../board.hpp"
+#include "../problem.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+void Check(bool condition, const char* what, const std::string& input) {
+    if (!condition) {
+        std::fprintf(stderr, "%s for input \"%s\"\n", what, input.c_str());
+        std::abort();
+    }
+}
+
+void CheckBoard(const std::string& text) {
+    std::vector<std::vector<int>> state;
+    if (!board::Parse(text, &state)) {
+        return;
+    }
+    bool seen[board::kCells] = { false };
+    for (int i = 0; i < board::kCells; i++) {
+        int tile = state[i / board::kSide][i % board::kSide];
+        Check(tile >= 0 && tile < board::kCells && !seen[tile],
+              "board::Parse() accepted a repeated or invalid tile", text);
+        seen[tile] = true;
+    }
+    Check(board::Format(state) == text, "Format() changed the board", text);
+    Check(board::FromKey(board::ToKey(state)) == state,
+          "ToKey() does not round trip", text);
+    Check(board::Unpack(board::Pack(state)) == state,
+          "Pack() does not round trip", text);
+}
+
+void CheckTextBoards(const std::string& text) {
+    std::vector<uint32_t> keys;
+    std::string error;
+    if (!batch_io::ParseTextBoards(text.data(), text.size(), &keys,
+                                   &error)) {
+        return;
+    }
+    std::string grids;
+    for (uint32_t key : keys) {
+        Check(key < board::kNumKeys,
+              "ParseTextBoards() returned an invalid key", text);
+        grids += batch_io::FormatGrid(key);
+    }
+    std::vector<uint32_t> reread;
+    Check(batch_io::ParseTextBoards(grids.data(), grids.size(), &reread,
+                                    &error) && reread == keys,
+          "FormatGrid() does not round trip", text);
+}
+
+void CheckRows(const std::string& text) {
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t end = text.find('\n', begin);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(begin, end - begin);
+        std::vector<int> row;
+        if (Problem::ParseCustomInput(line, &row)) {
+            for (int tile : row) {
+                Check(tile >= 0 && tile < board::kCells,
+                      "ParseCustomInput() accepted a non-tile", line);
+            }
+        }
+        begin = end + 1;
+    }
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    std::string text(reinterpret_cast<const char*>(data), size);
+    CheckBoard(text);
+    CheckTextBoards(text);
+    CheckRows(text);
+    return 0;
+}
+
+#ifdef FUZZ_PARSE_MAIN
+
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace {
+
+// Characters the parsers treat specially, plus a few they must reject.
+const char kAlphabet[] = "0123456789 \t\r\n[],-+x\0";
+
+// Runs inputs near the valid ones: boards and rows with a few characters
+// replaced, inserted or removed, and plain random strings.
+void RunGenerated(int count) {
+    uint64_t seed = 1;
+    const std::string kValid[] = {
+        "123456780", "867254301", "1 2 3", "4\t5 6\n7 8 0",
+        "[ 8 6 7 ]\n[ 2 5 4 ]\n[ 3 0 1 ]\n", "123456780\n012345678\n"
+    };
+    const int kNumValid = sizeof(kValid) / sizeof(kValid[0]);
+    for (int n = 0; n < count; n++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t bits = seed >> 16;
+        std::string text = kValid[bits % kNumValid];
+        if (n % 8 == 0) {
+            text.assign(bits % 16, ' ');
+        }
+        int edits = 1 + (bits >> 40) % 3;
+        for (int edit = 0; edit < edits; edit++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint64_t r = seed >> 16;
+            char c = kAlphabet[r % (sizeof(kAlphabet) - 1)];
+            size_t at = text.empty() ? 0 : (r >> 8) % (text.size() + 1);
+            switch ((r >> 24) % 3) {
+                case 0: text.insert(at, 1, c); break;
+                case 1: if (at < text.size()) { text[at] = c; } break;
+                default: if (at < text.size()) { text.erase(at, 1); }
+            }
+        }
+        LLVMFuzzerTestOneInput(
+            reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    }
+    std::printf("fuzz_parse: %d generated inputs passed\n", count);
+}
+
+// Writes 'size' bytes of a batch file starting with 'header' and followed
+// by 'key' repeated, and reports whether BoardFile or ReadRecordFile()
+// accepts it.
+bool Accepts(const char magic[4], uint64_t count, size_t size,
+             uint32_t key) {
+    char path[] = "/tmp/fuzz_parse_XXXXXX";
+    int fd = mkstemp(path);
+    Check(fd >= 0, "mkstemp() failed", path);
+    batch_io::FileHeader header;
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = batch_io::kVersion;
+    header.count = count;
+    std::string bytes(reinterpret_cast<const char*>(&header),
+                      sizeof(header));
+    while (bytes.size() < size) {
+        bytes.append(reinterpret_cast<const char*>(&key), sizeof(key));
+    }
+    bytes.resize(size);
+    bool written = write(fd, bytes.data(), bytes.size()) ==
+                   static_cast<ssize_t>(bytes.size());
+    close(fd);
+    Check(written, "write() failed", path);
+    std::string error;
+    bool accepted;
+    if (std::memcmp(magic, "8PZB", 4) == 0) {
+        batch_io::BoardFile boards;
+        accepted = boards.Open(path, &error);
+    } else {
+        std::vector<batch_io::SolutionRecord> records;
+        accepted = batch_io::ReadRecordFile(path, &records, &error);
+    }
+    unlink(path);
+    return accepted;
+}
+
+// Checks the batch readers against crafted headers.
+void RunBatchHeaders() {
+    const size_t kHeader = sizeof(batch_io::FileHeader);
+    const size_t kRecord = sizeof(batch_io::SolutionRecord);
+    Check(Accepts("8PZB", 2, kHeader + 8, 0), "valid board file rejected",
+          "8PZB");
+    Check(Accepts("8PZS", 2, kHeader + 2 * kRecord, 0),
+          "valid solution file rejected", "8PZS");
+    Check(!Accepts("8PZB", 0, kHeader - 1, 0), "truncated header accepted",
+          "8PZB");
+    Check(!Accepts("8PZB", 3, kHeader + 8, 0), "missing board accepted",
+          "8PZB");
+    // Counts whose expected size wraps around to the real size.
+    Check(!Accepts("8PZB", (1ULL << 62) + 1, kHeader + 4, 0),
+          "overflowing board count accepted", "8PZB");
+    Check(!Accepts("8PZS", (1ULL << 61) + 1, kHeader + kRecord, 0),
+          "overflowing record count accepted", "8PZS");
+    std::printf("fuzz_parse: crafted batch headers rejected\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc == 1) {
+        RunGenerated(200000);
+        RunBatchHeaders();
+        return 0;
+    }
+    for (int i = 1; i < argc; i++) {
+        std::ifstream file(argv[i], std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        std::string text = contents.str();
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(text.data()),
+                               text.size());
+    }
+    return 0;
+}
+
+#endif  // FUZZ_PARSE_MAIN
@@ -0,0 +1,216 @@
+// Emits tables.hpp, the lookup tables behind the Solver heuristics, as
+// constexpr arrays. Run by the Makefile before anything that includes
+// tables.hpp is compiled, so the program starts with the tables already
+// in read-only data instead of building them at startup.
+//
+// Usage: gen_tables > tables.hpp
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int kSide = 3;
+const int kCells = kSide * kSide;
+const int kNoCell = -1;
+
+std::string ToString(int value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%d", value);
+    return buffer;
+}
+
+std::string ToString(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    return buffer;
+}
+
+// Cell a tile belongs to in the goal state. The blank belongs last.
+int GoalCell(int tile) {
+    return tile == 0 ? kCells - 1 : tile - 1;
+}
+
+// Cell the blank reaches from 'cell' by moving UP, DOWN, LEFT or RIGHT.
+int Neighbor(int cell, int move) {
+    int row = cell / kSide;
+    int col = cell % kSide;
+    switch (move) {
+        case 0: row--; break;
+        case 1: row++; break;
+        case 2: col--; break;
+        default: col++; break;
+    }
+    if (row < 0 || row >= kSide || col < 0 || col >= kSide) {
+        return kNoCell;
+    }
+    return row * kSide + col;
+}
+
+// Additive pattern database for the four tiles in 'pattern'. Moves of any
+// other tile are free, so the two halves of a disjoint partition can be
+// summed. Entries are indexed by the cells of the four tiles in base 9.
+std::vector<std::string> BuildPatternDatabase(const int pattern[4]) {
+    const int kPatternStates = kCells * kCells * kCells * kCells;
+    const int kUnreached = 255;
+    // Abstract state: pattern index * kCells + blank cell.
+    std::vector<int> distance(kPatternStates * kCells, kUnreached);
+    std::deque<int> queue;
+
+    int goal_index = 0;
+    for (int i = 0; i < 4; i++) {
+        goal_index = goal_index * kCells + GoalCell(pattern[i]);
+    }
+    for (int blank = 0; blank < kCells; blank++) {
+        bool free = true;
+        for (int i = 0; i < 4; i++) {
+            if (GoalCell(pattern[i]) == blank) { free = false; }
+        }
+        if (free) {
+            distance[goal_index * kCells + blank] = 0;
+            queue.push_back(goal_index * kCells + blank);
+        }
+    }
+
+    // 0-1 breadth first search backward from every goal placement.
+    while (!queue.empty()) {
+        int state = queue.front();
+        queue.pop_front();
+        int blank = state % kCells;
+        int cells[4];
+        int rest = state / kCells;
+        for (int i = 3; i >= 0; i--) {
+            cells[i] = rest % kCells;
+            rest /= kCells;
+        }
+        for (int move = 0; move < 4; move++) {
+            int next_blank = Neighbor(blank, move);
+            if (next_blank == kNoCell) { continue; }
+            int cost = 0;
+            int next_cells[4];
+            for (int i = 0; i < 4; i++) {
+                next_cells[i] = cells[i];
+                if (cells[i] == next_blank) {
+                    next_cells[i] = blank;
+                    cost = 1;
+                }
+            }
+            int next = 0;
+            for (int i = 0; i < 4; i++) {
+                next = next * kCells + next_cells[i];
+            }
+            next = next * kCells + next_blank;
+            if (distance[state] + cost < distance[next]) {
+                distance[next] = distance[state] + cost;
+                if (cost == 0) {
+                    queue.push_front(next);
+                } else {
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    std::vector<std::string> database;
+    for (int index = 0; index < kPatternStates; index++) {
+        int best = kUnreached;
+        for (int blank = 0; blank < kCells; blank++) {
+            if (distance[index * kCells + blank] < best) {
+                best = distance[index * kCells + blank];
+            }
+        }
+        // Unreachable indices repeat a cell and are never looked up.
+        database.push_back(ToString(best == kUnreached ? 0 : best));
+    }
+    return database;
+}
+
+// Prints 'values' as an initialized array. Rows of a two dimensional
+// array ('nested') get their own braces; flat arrays wrap every 'per_line'.
+void PrintArray(const char* declaration, const std::vector<std::string>& values,
+                size_t per_line, bool nested) {
+    std::printf("%s = {", declaration);
+    for (size_t i = 0; i < values.size(); i++) {
+        bool first_in_line = i % per_line == 0;
+        bool last_in_line = i % per_line == per_line - 1 ||
+            i + 1 == values.size();
+        if (first_in_line) {
+            std::printf("\n    %s", nested ? "{ " : "");
+        } else {
+            std::printf(" ");
+        }
+        std::printf("%s", values[i].c_str());
+        if (nested && last_in_line) {
+            std::printf(" }");
+        }
+        if (i + 1 < values.size()) {
+            std::printf(",");
+        }
+    }
+    std::printf("\n};\n\n");
+}
+
+}  // namespace
+
+int main() {
+    std::printf("// Generated by tools/gen_tables. Do not edit.\n");
+    std::printf("#ifndef TABLES_HPP\n#define TABLES_HPP\n\n");
+    std::printf("#include <cstdint>\n\n");
+    std::printf("namespace tables {\n\n");
+
+    // Tiles are the first index and cells the second in each of these.
+    std::vector<std::string> misplaced;
+    std::vector<std::string> manhattan;
+    std::vector<std::string> euclidian;
+    for (int tile = 0; tile < kCells; tile++) {
+        for (int cell = 0; cell < kCells; cell++) {
+            int goal = GoalCell(tile);
+            int rows = goal / kSide - cell / kSide;
+            int cols = goal % kSide - cell % kSide;
+            bool counted = tile != 0;  // The blank never adds to a heuristic.
+            misplaced.push_back(ToString(counted && goal != cell ? 1 : 0));
+            manhattan.push_back(ToString(
+                counted ? std::abs(rows) + std::abs(cols) : 0));
+            euclidian.push_back(ToString(
+                counted ? std::sqrt(std::pow(rows, 2) + std::pow(cols, 2))
+                        : 0.0));
+        }
+    }
+
+    std::printf("/// Whether tile t on cell c is out of place.\n");
+    PrintArray("constexpr uint8_t kMisplaced[9][9]", misplaced, kCells, true);
+    std::printf("/// Manhattan distance from cell c to tile t's goal cell.\n");
+    PrintArray("constexpr uint8_t kManhattan[9][9]", manhattan, kCells, true);
+
+    std::printf("/// Euclidian distance from cell c to tile t's goal "
+                "cell.\n");
+    PrintArray("constexpr double kEuclidian[9][9]", euclidian, kCells, true);
+
+    std::vector<std::string> neighbors;
+    for (int cell = 0; cell < kCells; cell++) {
+        for (int move = 0; move < 4; move++) {
+            neighbors.push_back(ToString(Neighbor(cell, move)));
+        }
+    }
+    std::printf("/// Cell the blank reaches from cell c with move m (in "
+                "board::Move order),\n/// or -1 if it would leave the "
+                "board.\n");
+    PrintArray("constexpr int8_t kNeighbor[9][4]", neighbors, 4, true);
+
+    const int kLowTiles[4] = { 1, 2, 3, 4 };
+    const int kHighTiles[4] = { 5, 6, 7, 8 };
+    std::printf("/// Additive pattern databases for tiles 1-4 and 5-8. "
+                "Index with the cells\n/// of the four tiles in base 9, "
+                "lowest tile first.\n");
+    PrintArray("constexpr uint8_t kPatternLow[6561]",
+               BuildPatternDatabase(kLowTiles), 27, false);
+    PrintArray("constexpr uint8_t kPatternHigh[6561]",
+               BuildPatternDatabase(kHighTiles), 27, false);
+
+    std::printf("}  // namespace tables\n\n#endif // TABLES_HPP\n");
+    return 0;
+}
@@ -0,0 +1,104 @@
+// Random board generator for load testing.
+//
+// Streams solvable boards in the batch input format, one board per line
+// as nine digits in row-major order (see board::Parse()), which is what
+// loadgen --boards reads. Boards are either uniform over all solvable
+// boards, or uniform over the boards whose optimal solution is exactly
+// --depth moves long. The same --seed always produces the same output.
+//
+// Usage: genboards [--count N] [--seed S] [--depth D] [--output FILE]
+
+#include "../board.hpp"
+#include "../generator.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    unsigned long long count = 1000;
+    unsigned long long seed = 1;
+    int depth = -1;
+    std::string output;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--count") { count = std::strtoull(argv[i + 1], 0, 10); }
+        else if (flag == "--seed") {
+            seed = std::strtoull(argv[i + 1], 0, 10);
+        } else if (flag == "--depth") { depth = std::atoi(argv[i + 1]); }
+        else if (flag == "--output") { output = argv[i + 1]; }
+        else {
+            std::cerr << "Usage: genboards [--count N] [--seed S] " <<
+                "[--depth D] [--output FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::FILE* out = output.empty() ? stdout : std::fopen(output.c_str(),
+                                                          "wb");
+    if (out == nullptr) {
+        std::cerr << "Could not open " << output << std::endl;
+        return 1;
+    }
+
+    std::chrono::steady_clock::time_point began =
+        std::chrono::steady_clock::now();
+    DistanceTable* distances = nullptr;
+    SolvableBoardList* solvable = nullptr;
+    if (depth < 0) {
+        solvable = new SolvableBoardList();
+    } else {
+        distances = new DistanceTable();
+        if (depth > distances->MaxDistance()) {
+            std::cerr << "No board is more than " <<
+                distances->MaxDistance() << " moves away." << std::endl;
+            return 1;
+        }
+    }
+
+    // Lines are assembled in a large buffer and written in big chunks.
+    const size_t kLine = SolvableBoardList::kLineLength;
+    const size_t kBufferLines = 1 << 16;
+    std::vector<char> buffer(kLine * kBufferLines);
+    BoardGenerator generator(seed);
+    uint8_t cells[board::kCells];
+    unsigned long long written = 0;
+    while (written < count) {
+        size_t lines = count - written < kBufferLines ? count - written :
+            kBufferLines;
+        char* line = &buffer[0];
+        for (size_t i = 0; i < lines; i++) {
+            if (solvable) {
+                std::memcpy(line, solvable->Line(
+                    generator.Below(solvable->Size())), kLine);
+            } else {
+                generator.NextAtDepth(*distances, depth, cells);
+                for (int j = 0; j < board::kCells; j++) {
+                    line[j] = '0' + cells[j];
+                }
+                line[board::kCells] = '\n';
+            }
+            line += kLine;
+        }
+        if (std::fwrite(&buffer[0], kLine, lines, out) != lines) {
+            std::cerr << "Write failed." << std::endl;
+            return 1;
+        }
+        written += lines;
+    }
+    std::fflush(out);
+    double elapsed_s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - began).count();
+    delete distances;
+    delete solvable;
+    if (out != stdout) { std::fclose(out); }
+
+    std::cerr << "Generated " << count << " board(s) with seed " << seed <<
+        " in " << elapsed_s << " s (" << count / elapsed_s <<
+        " boards/s)." << std::endl;
+    return 0;
+}
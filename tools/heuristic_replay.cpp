@@ -0,0 +1,117 @@
+// Measures what a LearnedHeuristic saves on a replayed traffic log.
+//
+// Reads boards one per line in the format of board::Parse(), as written by
+// genboards, and solves each one twice: cold, with the static heuristic
+// only, and warm, with a LearnedHeuristic shared by the whole replay that
+// every solve adds to. The log is replayed --passes times, so the second
+// pass shows exact repeats. For every pass it prints the nodes expanded
+// cold and warm, the reduction, the share of heuristic lookups that found
+// a learned bound and the share where that bound beat the static one.
+// Warm solutions are checked to be exactly as long as the cold ones.
+//
+// Usage: heuristic_replay <log file> [--algorithm NAME] [--passes N]
+//                         [--path-only]
+
+#include "../board.hpp"
+#include "../learned_heuristic.hpp"
+#include "../problem.hpp"
+#include "../solution.hpp"
+#include "../solver.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: heuristic_replay <log file> "
+                     "[--algorithm NAME] [--passes N] [--path-only]\n");
+        return 1;
+    }
+    std::string algorithm = "manhattan";
+    int passes = 2;
+    bool learn_closed = true;
+    for (int i = 2; i < argc; i++) {
+        std::string flag = argv[i];
+        if (flag == "--algorithm" && i + 1 < argc) { algorithm = argv[++i]; }
+        else if (flag == "--passes" && i + 1 < argc) {
+            passes = std::atoi(argv[++i]);
+        } else if (flag == "--path-only") { learn_closed = false; }
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    std::ifstream log(argv[1]);
+    if (!log) {
+        std::fprintf(stderr, "Could not open %s\n", argv[1]);
+        return 1;
+    }
+    Solver solve;
+    std::vector<Problem> puzzles;
+    std::string line;
+    while (std::getline(log, line)) {
+        std::vector<std::vector<int>> start;
+        if (line.empty() || !board::Parse(line, &start)) {
+            continue;
+        }
+        Problem puzzle;
+        puzzle.Init(start);
+        if (solve.IsSolvable(puzzle)) {
+            puzzles.push_back(puzzle);
+        }
+    }
+
+    // The cold runs do not depend on the pass, so they are solved once.
+    std::vector<Solution> cold(puzzles.size());
+    long long cold_expanded = 0;
+    for (size_t i = 0; i < puzzles.size(); i++) {
+        if (!solve.Solve(puzzles[i], algorithm, SearchOptions(), &cold[i])) {
+            std::fprintf(stderr, "Unknown algorithm %s\n", algorithm.c_str());
+            return 1;
+        }
+        cold_expanded += cold[i].GetNodesExpanded();
+    }
+
+    LearnedHeuristic learned(learn_closed);
+    SearchOptions options;
+    options.learned_heuristic = &learned;
+    int wrong = 0;
+    std::printf("%zu boards, %s, learning from %s\n", puzzles.size(),
+                algorithm.c_str(),
+                learn_closed ? "paths and closed states" : "paths");
+    std::printf("%-5s %12s %12s %10s %9s %10s %14s\n", "pass", "cold",
+                "warm", "reduction", "hit rate", "tightened",
+                "states learned");
+    for (int pass = 1; pass <= passes; pass++) {
+        long long warm_expanded = 0;
+        long long lookups = learned.Lookups();
+        long long known = learned.Known();
+        long long tightened = learned.Tightened();
+        for (size_t i = 0; i < puzzles.size(); i++) {
+            Solution warm;
+            solve.Solve(puzzles[i], algorithm, options, &warm);
+            warm_expanded += warm.GetNodesExpanded();
+            if (!warm.Found() || warm.Length() != cold[i].Length()) {
+                wrong++;
+            }
+        }
+        lookups = learned.Lookups() - lookups;
+        known = learned.Known() - known;
+        tightened = learned.Tightened() - tightened;
+        std::printf("%-5d %12lld %12lld %9.1f%% %8.1f%% %9.1f%% %14lld\n",
+                    pass, cold_expanded, warm_expanded,
+                    cold_expanded ?
+                        100.0 - 100.0 * warm_expanded / cold_expanded : 0.0,
+                    lookups ? 100.0 * known / lookups : 0.0,
+                    lookups ? 100.0 * tightened / lookups : 0.0,
+                    learned.StatesLearned());
+    }
+    if (wrong) {
+        std::printf("%d warm solutions differ in length\n", wrong);
+    }
+    return wrong == 0 ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+// Load generator for the solver daemon started with ./puzzle --serve.
+//
+// Keeps up to --window requests in flight on a single connection, cycling
+// through a list of boards, and reports throughput and latency percentiles
+// once every response has arrived.
+//
+// Usage: loadgen --socket PATH [--requests N] [--window W]
+//                [--algorithm ucs|misplaced|euclidian|manhattan|pdb]
+//                [--time-limit MS] [--boards FILE]
+//
+// FILE holds one board per line in the format of board::Parse(), for
+// example "867254301". Without it the README's default puzzles are used.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+typedef std::chrono::steady_clock Clock;
+
+int main(int argc, char* argv[]) {
+    std::string socket_path;
+    std::string algorithm = "euclidian";
+    std::string boards_path;
+    long requests = 1000;
+    long window = 32;
+    long time_limit_ms = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--socket") { socket_path = argv[i + 1]; }
+        else if (flag == "--requests") { requests = std::atol(argv[i + 1]); }
+        else if (flag == "--window") { window = std::atol(argv[i + 1]); }
+        else if (flag == "--algorithm") { algorithm = argv[i + 1]; }
+        else if (flag == "--time-limit") {
+            time_limit_ms = std::atol(argv[i + 1]);
+        } else if (flag == "--boards") { boards_path = argv[i + 1]; }
+        else {
+            std::cerr << "Unknown option " << flag << std::endl;
+            return 1;
+        }
+    }
+    if (socket_path.empty() || requests < 1 || window < 1) {
+        std::cerr << "Usage: loadgen --socket PATH [--requests N] " <<
+            "[--window W] " <<
+            "[--algorithm ucs|misplaced|euclidian|manhattan|pdb] " <<
+            "[--time-limit MS] [--boards FILE]" << std::endl;
+        return 1;
+    }
+
+    // Trivial, Very Easy, Easy, Doable and Oh Boy from the README.
+    std::vector<std::string> boards = {
+        "123456780", "123456708", "120453786", "012453786", "871602543"
+    };
+    if (!boards_path.empty()) {
+        std::ifstream file(boards_path);
+        std::string line;
+        boards.clear();
+        while (std::getline(file, line)) {
+            if (!line.empty()) { boards.push_back(line); }
+        }
+        if (boards.empty()) {
+            std::cerr << "No boards found in " << boards_path << std::endl;
+            return 1;
+        }
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(),
+                 sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address),
+                          sizeof(address)) != 0) {
+        std::cerr << "Could not connect to " << socket_path << ": " <<
+            std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    std::vector<Clock::time_point> sent_at(requests);
+    std::vector<double> latencies_ms;
+    latencies_ms.reserve(requests);
+    long sent = 0;
+    long received = 0;
+    long ok = 0, timed_out = 0, unsolvable = 0, cancelled = 0, failed = 0;
+    std::string pending;
+    char buffer[65536];
+    Clock::time_point began = Clock::now();
+
+    while (received < requests) {
+        std::string batch;
+        while (sent < requests && sent - received < window) {
+            std::ostringstream line;
+            line << sent << " " << algorithm << " " << time_limit_ms << " " <<
+                boards[sent % boards.size()] << "\n";
+            batch += line.str();
+            sent_at[sent++] = Clock::now();
+        }
+        size_t written = 0;
+        while (written < batch.size()) {
+            ssize_t count = write(fd, batch.data() + written,
+                                  batch.size() - written);
+            if (count <= 0) {
+                std::cerr << "Connection lost while sending." << std::endl;
+                return 1;
+            }
+            written += count;
+        }
+
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count <= 0) {
+            std::cerr << "Connection lost after " << received <<
+                " response(s)." << std::endl;
+            return 1;
+        }
+        Clock::time_point now = Clock::now();
+        pending.append(buffer, count);
+        size_t begin = 0;
+        size_t end;
+        while ((end = pending.find('\n', begin)) != std::string::npos) {
+            std::istringstream response(pending.substr(begin, end - begin));
+            begin = end + 1;
+            long id;
+            std::string status;
+            if (!(response >> id >> status) || id < 0 || id >= sent) {
+                failed++;
+            } else {
+                latencies_ms.push_back(
+                    std::chrono::duration<double, std::milli>(
+                        now - sent_at[id]).count());
+                if (status == "OK") { ok++; }
+                else if (status == "TIMEOUT") { timed_out++; }
+                else if (status == "UNSOLVABLE") { unsolvable++; }
+                else if (status == "CANCELLED") { cancelled++; }
+                else { failed++; }
+            }
+            received++;
+        }
+        pending.erase(0, begin);
+    }
+    double elapsed_s =
+        std::chrono::duration<double>(Clock::now() - began).count();
+    close(fd);
+
+    std::sort(latencies_ms.begin(), latencies_ms.end());
+    std::cout << "Requests: " << requests << " (ok " << ok << ", timeout " <<
+        timed_out << ", unsolvable " << unsolvable << ", cancelled " <<
+        cancelled << ", error " << failed << ")\n";
+    std::cout << "Elapsed: " << elapsed_s << " s, QPS: " <<
+        requests / elapsed_s << "\n";
+    if (!latencies_ms.empty()) {
+        size_t n = latencies_ms.size();
+        std::cout << "Latency ms: p50 " << latencies_ms[n / 2] <<
+            ", p90 " << latencies_ms[n * 90 / 100] <<
+            ", p99 " << latencies_ms[n * 99 / 100] <<
+            ", max " << latencies_ms[n - 1] << "\n";
+    }
+    return failed ? 1 : 0;
+}
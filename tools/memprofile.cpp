@@ -0,0 +1,145 @@
+// Reports how much memory the search uses and what it is spent on.
+//
+// Without --series, draws --count solvable boards with a seeded
+// BoardGenerator, solves each one with SearchOptions::memory_profile set
+// and prints the median, 95th percentile and largest peak of every
+// MemoryCategory across the corpus, in KiB.
+//
+// With --series BOARD, solves that one board and prints its time series as
+// CSV instead: one row every --interval expansions with the live bytes of
+// each category, ready to plot.
+//
+// Usage: memprofile [--count N] [--seed S] [--algorithm NAME]
+//                   [--series BOARD] [--interval K]
+
+#include "../board.hpp"
+#include "../generator.hpp"
+#include "../memory_stats.hpp"
+#include "../problem.hpp"
+#include "../solution.hpp"
+#include "../solver.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Value below which 'fraction' of 'values' fall. Sorts 'values'.
+double Percentile(std::vector<size_t>* values, double fraction) {
+    std::sort(values->begin(), values->end());
+    size_t i = static_cast<size_t>(fraction * (values->size() - 1));
+    return (*values)[i] / 1024.0;
+}
+
+int PrintSeries(const Solver& solve, const std::string& text,
+                const std::string& algorithm, int interval) {
+    std::vector<std::vector<int>> start;
+    if (!board::Parse(text, &start)) {
+        std::fprintf(stderr, "Invalid board %s\n", text.c_str());
+        return 1;
+    }
+    Problem puzzle;
+    puzzle.Init(start);
+    MemoryProfile profile;
+    SearchOptions options;
+    options.memory_profile = &profile;
+    options.memory_sample_interval = interval;
+    Solution solution;
+    if (!solve.Solve(puzzle, algorithm, options, &solution)) {
+        std::fprintf(stderr, "Unknown algorithm %s\n", algorithm.c_str());
+        return 1;
+    }
+    std::printf("nodes_expanded,seconds");
+    for (int i = 0; i < kMemoryCategories; i++) {
+        std::string name =
+            MemoryCategoryName(static_cast<MemoryCategory>(i));
+        std::replace(name.begin(), name.end(), ' ', '_');
+        std::printf(",%s", name.c_str());
+    }
+    std::printf("\n");
+    for (const MemorySample& sample : profile.samples) {
+        std::printf("%d,%.6f", sample.nodes_expanded,
+                    sample.elapsed_seconds);
+        for (int i = 0; i < kMemoryCategories; i++) {
+            std::printf(",%zu", sample.live[i]);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int count = 1000;
+    unsigned long long seed = 1;
+    std::string algorithm = "pdb";
+    std::string series;
+    int interval = 1024;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--count") { count = std::atoi(argv[i + 1]); }
+        else if (flag == "--seed") {
+            seed = std::strtoull(argv[i + 1], 0, 10);
+        } else if (flag == "--algorithm") { algorithm = argv[i + 1]; }
+        else if (flag == "--series") { series = argv[i + 1]; }
+        else if (flag == "--interval") { interval = std::atoi(argv[i + 1]); }
+        else {
+            std::fprintf(stderr, "Usage: memprofile [--count N] [--seed S] "
+                         "[--algorithm NAME] [--series BOARD] "
+                         "[--interval K]\n");
+            return 1;
+        }
+    }
+    if (count <= 0) {
+        std::fprintf(stderr, "--count must be positive\n");
+        return 1;
+    }
+    if (interval <= 0) {
+        std::fprintf(stderr, "--interval must be positive\n");
+        return 1;
+    }
+
+    Solver solve;
+    if (!series.empty()) {
+        return PrintSeries(solve, series, algorithm, interval);
+    }
+
+    BoardGenerator generator(seed);
+    std::vector<size_t> peaks[kMemoryCategories + 1];  // Last is the total.
+    uint8_t cells[board::kCells];
+    for (int n = 0; n < count; n++) {
+        generator.NextUniform(cells);
+        Problem puzzle;
+        puzzle.Init(board::FromCells(cells));
+        MemoryProfile profile;
+        SearchOptions options;
+        options.memory_profile = &profile;
+        options.memory_sample_interval = interval;
+        Solution solution;
+        if (!solve.Solve(puzzle, algorithm, options, &solution)) {
+            std::fprintf(stderr, "Unknown algorithm %s\n", algorithm.c_str());
+            return 1;
+        }
+        for (int i = 0; i < kMemoryCategories; i++) {
+            peaks[i].push_back(profile.peak[i]);
+        }
+        peaks[kMemoryCategories].push_back(profile.total_peak);
+    }
+
+    std::printf("%d boards, seed %llu, %s, peak KiB per search\n", count,
+                seed, algorithm.c_str());
+    std::printf("%-17s %10s %10s %10s\n", "category", "median", "p95", "max");
+    for (int i = 0; i <= kMemoryCategories; i++) {
+        const char* name = i < kMemoryCategories ?
+            MemoryCategoryName(static_cast<MemoryCategory>(i)) : "total";
+        double median = Percentile(&peaks[i], 0.5);
+        double p95 = Percentile(&peaks[i], 0.95);
+        std::printf("%-17s %10.1f %10.1f %10.1f\n", name, median, p95,
+                    peaks[i].back() / 1024.0);
+    }
+    return 0;
+}
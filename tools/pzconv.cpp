@@ -0,0 +1,100 @@
+// Converts between the human-readable board formats and the binary batch
+// files described in batch_io.hpp.
+//
+// Usage: pzconv to-bin TEXT_IN BOARDS_OUT   text boards -> board file
+//        pzconv to-text BOARDS_IN           board file -> grids on stdout
+//        pzconv records SOLUTIONS_IN        solution file -> one line per
+//                                           puzzle on stdout
+//
+// Text input may hold nine-digit boards (the genboards output) or grids of
+// nine numbers over several lines. Records print as
+// "<board> <status> <length> <moves> <nodes expanded> <max queue size>".
+
+#include "../batch_io.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+const char* const kStatusNames[] = {
+    "FOUND", "EXHAUSTED", "TIMEOUT", "UNSOLVABLE", "CANCELLED"
+};
+
+int Usage() {
+    std::cerr << "Usage: pzconv to-bin TEXT_IN BOARDS_OUT\n" <<
+        "       pzconv to-text BOARDS_IN\n" <<
+        "       pzconv records SOLUTIONS_IN" << std::endl;
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return Usage();
+    }
+    std::string command = argv[1];
+    std::string error;
+
+    if (command == "to-bin" && argc == 4) {
+        batch_io::MappedFile text;
+        if (!text.Open(argv[2])) {
+            std::cerr << "Could not read " << argv[2] << std::endl;
+            return 1;
+        }
+        std::vector<uint32_t> keys;
+        if (!batch_io::ParseTextBoards(text.Data(), text.Size(), &keys,
+                                       &error)) {
+            std::cerr << argv[2] << ": " << error << std::endl;
+            return 1;
+        }
+        if (!batch_io::WriteBoardFile(argv[3], keys)) {
+            std::cerr << "Could not write " << argv[3] << std::endl;
+            return 1;
+        }
+        std::cerr << "Wrote " << keys.size() << " board(s)." << std::endl;
+        return 0;
+    }
+
+    if (command == "to-text" && argc == 3) {
+        batch_io::BoardFile boards;
+        if (!boards.Open(argv[2], &error)) {
+            std::cerr << argv[2] << ": " << error << std::endl;
+            return 1;
+        }
+        batch_io::BufferedWriter out(STDOUT_FILENO);
+        for (uint64_t i = 0; i < boards.Count(); i++) {
+            out.Write(batch_io::FormatGrid(boards.Key(i)));
+        }
+        return out.Flush() ? 0 : 1;
+    }
+
+    if (command == "records" && argc == 3) {
+        std::vector<batch_io::SolutionRecord> records;
+        if (!batch_io::ReadRecordFile(argv[2], &records, &error)) {
+            std::cerr << argv[2] << ": " << error << std::endl;
+            return 1;
+        }
+        batch_io::BufferedWriter out(STDOUT_FILENO);
+        for (const batch_io::SolutionRecord& record : records) {
+            std::ostringstream line;
+            std::string moves = batch_io::RecordMoves(record);
+            line << board::Format(board::FromKey(record.board)) << " " <<
+                (record.status <= batch_io::kRecordCancelled ?
+                 kStatusNames[record.status] : "?") << " " <<
+                static_cast<int>(record.length) << " " <<
+                (moves.empty() ? "-" : moves) << " " <<
+                record.nodes_expanded << " " << record.max_frontier_size <<
+                "\n";
+            out.Write(line.str());
+        }
+        return out.Flush() ? 0 : 1;
+    }
+
+    return Usage();
+}
@@ -0,0 +1,104 @@
+// Measures what the two uses of reflection symmetry save on a random
+// corpus.
+//
+// Draws --count solvable boards uniformly with a seeded BoardGenerator and
+// solves each one four times with the same algorithm, with every
+// combination of SearchOptions::symmetry (a board and its reflection share
+// one node) and SearchOptions::reflected_lookup (the pattern database also
+// looks up the reflection). Prints the nodes expanded, states stored and
+// time of each run, and checks every solution against the exact distance
+// from DistanceTable.
+//
+// Usage: symmetry_bench [--count N] [--seed S] [--algorithm NAME]
+
+#include "../board.hpp"
+#include "../generator.hpp"
+#include "../problem.hpp"
+#include "../solution.hpp"
+#include "../solver.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Totals {
+    Totals() : expanded(0), stored(0), seconds(0), wrong(0) {}
+
+    long long expanded;
+    long long stored;
+    double seconds;
+    int wrong;  // Solutions that are not the shortest.
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int count = 1000;
+    unsigned long long seed = 1;
+    std::string algorithm = "pdb";
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string flag = argv[i];
+        if (flag == "--count") { count = std::atoi(argv[i + 1]); }
+        else if (flag == "--seed") {
+            seed = std::strtoull(argv[i + 1], 0, 10);
+        } else if (flag == "--algorithm") { algorithm = argv[i + 1]; }
+        else {
+            std::fprintf(stderr, "Usage: symmetry_bench [--count N] "
+                         "[--seed S] [--algorithm NAME]\n");
+            return 1;
+        }
+    }
+
+    DistanceTable distances;
+    BoardGenerator generator(seed);
+    Solver solve;
+    // Indexed by 2 * symmetry + reflected_lookup.
+    Totals totals[4];
+    uint8_t cells[board::kCells];
+    for (int n = 0; n < count; n++) {
+        generator.NextUniform(cells);
+        Problem puzzle;
+        puzzle.Init(board::FromCells(cells));
+        int shortest = distances.Distance(board::ToKey(cells));
+        for (int run = 0; run < 4; run++) {
+            SearchOptions options;
+            options.symmetry = run / 2 == 1;
+            options.reflected_lookup = run % 2 == 1;
+            Solution solution;
+            std::chrono::steady_clock::time_point began =
+                std::chrono::steady_clock::now();
+            if (!solve.Solve(puzzle, algorithm, options, &solution)) {
+                std::fprintf(stderr, "Unknown algorithm %s\n",
+                             algorithm.c_str());
+                return 1;
+            }
+            totals[run].seconds += std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - began).count();
+            totals[run].expanded += solution.GetNodesExpanded();
+            totals[run].stored += solution.GetNodesStored();
+            if (!solution.Found() || solution.Length() != shortest) {
+                totals[run].wrong++;
+            }
+        }
+    }
+
+    std::printf("%d boards, seed %llu, %s\n", count, seed, algorithm.c_str());
+    std::printf("%-9s %-17s %14s %14s %10s %9s\n", "symmetry",
+                "reflected lookup", "expanded/board", "stored/board",
+                "seconds", "wrong");
+    const char* const kNames[] = { "off", "on" };
+    int wrong = 0;
+    for (int run = 0; run < 4; run++) {
+        std::printf("%-9s %-17s %14.1f %14.1f %10.3f %9d\n",
+                    kNames[run / 2], kNames[run % 2],
+                    static_cast<double>(totals[run].expanded) / count,
+                    static_cast<double>(totals[run].stored) / count,
+                    totals[run].seconds, totals[run].wrong);
+        wrong += totals[run].wrong;
+    }
+    return wrong == 0 ? 0 : 1;
+}